@@ -0,0 +1,41 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "utils/data_generator.h"
+
+#include <benchmark/benchmark.h>
+
+namespace infini {
+
+// axis 3 concatenates short innermost rows (many small copies); axis 1
+// concatenates whole channel planes (few large ones)
+static void BM_ConcatAxis(benchmark::State &st) {
+    int axis = (int)st.range(0);
+    int s = (int)st.range(1);
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t1 = g->addTensor({1, 32, s, s}, DataType::Float32);
+    auto t2 = g->addTensor({1, 32, s, s}, DataType::Float32);
+    auto t3 = g->addTensor({1, 32, s, s}, DataType::Float32);
+    auto op = g->addOp<ConcatObj>(TensorVec{t1, t2, t3}, nullptr, axis);
+    g->dataMalloc();
+    t1->setData(IncrementalGenerator());
+    t2->setData(OneGenerator());
+    t3->setData(OneGenerator());
+
+    for (auto _ : st)
+        runtime->run(g);
+
+    size_t items = op->getOutput()->size();
+    st.SetItemsProcessed(st.iterations() * items);
+    st.SetBytesProcessed(st.iterations() * items * 2 * sizeof(float));
+}
+
+BENCHMARK(BM_ConcatAxis)
+    ->Args({1, 28})
+    ->Args({1, 112})
+    ->Args({2, 112})
+    ->Args({3, 28})
+    ->Args({3, 112});
+
+} // namespace infini
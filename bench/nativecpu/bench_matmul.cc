@@ -0,0 +1,43 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "utils/data_generator.h"
+
+#include <benchmark/benchmark.h>
+
+namespace infini {
+
+static void BM_Matmul(benchmark::State &st) {
+    int b = (int)st.range(0);
+    int m = (int)st.range(1);
+    int k = (int)st.range(2);
+    int n = (int)st.range(3);
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto A = g->addTensor({b, m, k}, DataType::Float32);
+    auto B = g->addTensor({b, k, n}, DataType::Float32);
+    g->addOp<MatmulObj>(A, B, nullptr);
+    g->dataMalloc();
+    A->setData(IncrementalGenerator());
+    B->setData(IncrementalGenerator());
+
+    for (auto _ : st)
+        runtime->run(g);
+
+    // items = multiply-accumulates; rate prints as effective FLOP/s / 2
+    st.SetItemsProcessed(st.iterations() * (int64_t)b * m * k * n);
+    st.SetBytesProcessed(st.iterations() * (int64_t)b *
+                         (m * k + k * n + m * n) * sizeof(float));
+}
+
+// production shape set: square GEMMs, a transformer-ish projection, a
+// skinny classifier head and a batched attention-sized case
+BENCHMARK(BM_Matmul)
+    ->Args({1, 64, 64, 64})
+    ->Args({1, 256, 256, 256})
+    ->Args({1, 512, 512, 512})
+    ->Args({1, 128, 768, 768})
+    ->Args({1, 1, 2048, 1000})
+    ->Args({8, 64, 64, 512});
+
+} // namespace infini
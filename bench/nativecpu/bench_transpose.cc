@@ -0,0 +1,49 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/transpose.h"
+#include "utils/data_generator.h"
+
+#include <benchmark/benchmark.h>
+
+namespace infini {
+
+static void benchTranspose(benchmark::State &st, const Shape &shape,
+                           const vector<int> &permute) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto input = g->addTensor(shape, DataType::Float32);
+    auto op = g->addOp<TransposeObj>(input, nullptr, permute);
+    g->dataMalloc();
+    input->setData(IncrementalGenerator());
+
+    for (auto _ : st)
+        runtime->run(g);
+
+    size_t items = op->getOutput()->size();
+    st.SetItemsProcessed(st.iterations() * items);
+    st.SetBytesProcessed(st.iterations() * items * 2 * sizeof(float));
+}
+
+// identity permutation: pure copy, the bandwidth ceiling for the rest
+static void BM_TransposeIdentity(benchmark::State &st) {
+    int s = (int)st.range(0);
+    benchTranspose(st, {1, 64, s, s}, {0, 1, 2, 3});
+}
+
+// last-two-dims swap: the class the matmul fusion rewrites away
+static void BM_TransposeLastTwoDims(benchmark::State &st) {
+    int s = (int)st.range(0);
+    benchTranspose(st, {1, 64, s, s}, {0, 1, 3, 2});
+}
+
+// NCHW <-> NHWC layout change: strided access on both sides
+static void BM_TransposeChannelsLast(benchmark::State &st) {
+    int s = (int)st.range(0);
+    benchTranspose(st, {1, 64, s, s}, {0, 2, 3, 1});
+}
+
+BENCHMARK(BM_TransposeIdentity)->Arg(28)->Arg(112)->Arg(224);
+BENCHMARK(BM_TransposeLastTwoDims)->Arg(28)->Arg(112)->Arg(224);
+BENCHMARK(BM_TransposeChannelsLast)->Arg(28)->Arg(112)->Arg(224);
+
+} // namespace infini
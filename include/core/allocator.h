@@ -20,25 +20,105 @@ namespace infini {
 
     size_t alignment;
 
-    // pointer to the memory actually allocated
+    // allocations at least this large are padded out to page boundaries;
+    // 0 disables the behavior
+    size_t pageAlignThreshold;
+
+    // the largest alignment handed out so far; getPtr over-allocates by
+    // this much so the base pointer itself can be aligned to it
+    size_t maxAlignment;
+
+    // pointer to the memory actually allocated (rawPtr) and its aligned
+    // base (ptr); rawPtr is what gets returned to the runtime
     void *ptr;
+    void *rawPtr;
+
+    // bytes backing rawPtr; reset() keeps the buffer, so getPtr only
+    // reallocates when a new plan outgrows it
+    size_t capacity;
+
+    // huge-page state: whether the next backing allocation should try
+    // huge pages, whether rawPtr came from mmap (and must be munmap'ed),
+    // and how many bytes ended up huge-page backed (or advised, see info)
+    bool hugePages;
+    bool mmapped;
+    size_t hugeBytes;
 
     // =================================== 作业 ===================================
     // TODO：可能需要设计一个数据结构来存储free block，以便于管理和合并
     // HINT: 可以使用一个 map 来存储 free block，key 为 block 的起始/结尾地址，value 为 block 的大小
     // =================================== 作业 ===================================
     std::map<size_t, size_t> freeBlocks;
-    
+
+    // the same blocks ordered by size, so alloc can best-fit in O(log n);
+    // kept in sync with freeBlocks by insertFreeBlock/eraseFreeBlock
+    std::multimap<size_t, size_t> freeBySize; // size -> addr
+
+    // instrumentation state, see setTracing: every alloc/free is recorded
+    // with the tensor fuid and op order index dataMalloc announces through
+    // setTraceContext
+    bool tracing;
+    UidBaseType traceFuid;
+    int traceOpIndex;
+
   public:
-    Allocator(Runtime runtime);
+    // one recorded alloc or free; ordering in the trace vector is event
+    // order, which doubles as the timeline's time axis
+    struct TraceEvent
+    {
+      bool isAlloc;
+      size_t addr;
+      size_t size;
+      UidBaseType fuid; // owning tensor family; 0 when unknown
+      int opIndex;      // op order index driving the event; -1 for
+                        // inputs/weights allocated before the first op
+      size_t usedAfter; // used bytes after the event
+    };
+    // 64-byte default alignment keeps tensors on their own cache lines
+    // (no false sharing at tensor boundaries) and satisfies aligned AVX
+    // loads; pageAlignThreshold > 0 additionally page-aligns allocations
+    // of at least that many bytes
+    static constexpr size_t pageSize = 4096;
+    static constexpr size_t hugePageSize = 2 << 20;
+    Allocator(Runtime runtime, size_t alignment = 64,
+              size_t pageAlignThreshold = 0);
+
+    // arenas own their backing buffer: movable so a new GraphObj can adopt
+    // a warm arena, never copyable
+    Allocator(Allocator &&other) noexcept;
+    Allocator(const Allocator &) = delete;
+    Allocator &operator=(const Allocator &) = delete;
 
     virtual ~Allocator();
 
+    // function: back the arena with 2MB huge pages, cutting TLB misses
+    // when kernels stream multi-GB weight arenas
+    // The next backing allocation first tries an explicit MAP_HUGETLB
+    // mapping and falls back to madvise(MADV_HUGEPAGE); how much of the
+    // arena ended up huge is reported through info().
+    void setHugePages(bool enable) { hugePages = enable; }
+
+    // function: materialize the arena and prefault every page, so the
+    // first inference does not eat the page-fault cost on the request
+    // path. Pages are touched read-modify-write in parallel across the
+    // worker pool, which preserves any data already bound (e.g. folded
+    // constants).
+    // return: milliseconds spent
+    double warmup();
+
+    // function: start a fresh plan over the same arena
+    // The block maps are cleared but the backing buffer is kept, so the
+    // next getPtr() reuses the warm, already-faulted pages and only
+    // reallocates (grow-only) when the new plan needs more bytes.
+    void reset();
+
     // function: simulate memory allocation
     // arguments：
     //     size: size of memory block to be allocated
+    //     align: minimum alignment for this block; 0 means the allocator
+    //            default. Must be a power of two.
     // return: head address offset of the allocated memory block
-    size_t alloc(size_t size);
+    size_t alloc(size_t size, size_t align = 0);
 
     // function: simulate memory free
     // arguments:
@@ -52,9 +132,81 @@ namespace infini {
 
     void info();
 
+    // function: the high-water mark of the simulated plan so far, i.e. the
+    // arena size getPtr() would materialize; lets callers cost a plan
+    // without committing memory
+    size_t getPeakBytes() const { return peak; }
+
+    // function: record every alloc/free with size, offset, tensor fuid and
+    // op order index, so peak memory can be attributed tensor by tensor.
+    // Off by default; enabling clears any previous trace.
+    void setTracing(bool enable);
+
+    // function: announce whose allocation/free the next calls belong to;
+    // dataMalloc calls this as it walks the ops
+    void setTraceContext(UidBaseType fuid, int opIndex)
+    {
+      traceFuid = fuid;
+      traceOpIndex = opIndex;
+    }
+
+    const vector<TraceEvent> &getTrace() const { return trace; }
+
+    // function: the recorded timeline in chrome://tracing JSON — one lane
+    // per arena offset with a block's lifetime as a B/E span, plus a
+    // "used bytes" counter track
+    std::string traceToChromeJson() const;
+
+    // function: the tensors live at the moment of peak usage, one line
+    // each (fuid, op index, offset, bytes), largest first — the direct
+    // answer to "which tensors drive the peak"
+    std::string peakContributionTable() const;
+
+    // function: write the recorded alloc/free sequence to a compact text
+    // file ("ITAT 1" header, then one event per line) that replayTrace
+    // can feed back through any allocator configuration. Frees reference
+    // the ordinal of the alloc they release, so replay is independent of
+    // the addresses this run happened to hand out.
+    void saveTrace(const std::string &path) const;
+
+    // what a replay measured: how the policy under test handled a
+    // captured workload
+    struct ReplayStats
+    {
+      size_t events;           // alloc/free events replayed
+      size_t peakBytes;        // high-water mark reached
+      double planMs;           // wall time spent in alloc/free calls
+      size_t freeBytes;        // free-list bytes after the replay
+      size_t largestFreeBlock; // largest free block after the replay
+    };
+
+    // function: reset this allocator and drive it with a trace captured
+    // by saveTrace, so policy changes (alignment, fit strategy, page
+    // thresholds) are judged on real model workloads
+    ReplayStats replayTrace(const std::string &path);
+
   private:
+    std::vector<TraceEvent> trace;
+
     // function: memory alignment, rouned up
     // return: size of the aligned memory block
     size_t getAlignedSize(size_t size);
+
+    // round a value up to a power-of-two boundary
+    static size_t roundUp(size_t value, size_t align)
+    {
+      return (value + align - 1) & ~(align - 1);
+    }
+
+    // insert/erase a free block in both indexes
+    void insertFreeBlock(size_t addr, size_t size);
+    void eraseFreeBlock(size_t addr, size_t size);
+
+    // append a trace event when tracing is on
+    void recordEvent(bool isAlloc, size_t addr, size_t size);
+
+    // acquire/release the backing buffer, honoring the huge-page setting
+    void allocBackingBuffer(size_t needed);
+    void releaseBackingBuffer();
   };
 }
@@ -2,8 +2,11 @@
 #include "core/allocator.h"
 #include "core/operator.h"
 #include "core/tensor.h"
+#include "utils/object_pool.h"
 #include <algorithm>
 #include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace infini
 {
@@ -19,8 +22,21 @@ namespace infini
     public:
         explicit GraphObj(Runtime runtime)
             : runtime(runtime), allocator(runtime), sorted(false){};
+
+        /**
+         * @brief Build a graph that adopts an existing allocator arena
+         * (e.g. from a graph being replaced), so re-planning reuses the
+         * warm backing buffer instead of reallocating it.
+         */
+        GraphObj(Runtime runtime, Allocator &&arena)
+            : runtime(runtime), allocator(std::move(arena)), sorted(false)
+        {
+            allocator.reset();
+        }
+
         string toString() const override;
         Runtime getRuntime() const { return runtime; }
+        Allocator &getAllocator() { return allocator; }
 
         Tensor addTensor(Shape dim, DataType dtype = DataType::Float32);
         Tensor addTensor(const Tensor &tensor);
@@ -29,19 +45,27 @@ namespace infini
         {
             auto it = std::find(ops.begin(), ops.end(), op);
             if (it != ops.end())
+            {
                 ops.erase(it);
+                opIndex.erase(op->getGuid());
+            }
         }
 
         void removeTensor(Tensor tensor)
         {
             auto it = std::find(tensors.begin(), tensors.end(), tensor);
             if (it != tensors.end())
+            {
                 tensors.erase(it);
+                tensorSet.erase(tensor.get());
+                fuidIndex.erase(tensor->getFuid());
+            }
         }
 
         const TensorVec &getTensors() const { return tensors; }
         const OpVec &getOperators() const { return ops; }
         Tensor getTensor(int) const;
+        Operator getOperator(UidBaseType guid) const;
 
         /**
          * @brief Sort the nodes in topological order.
@@ -53,9 +77,104 @@ namespace infini
 
         void optimize();
 
+        /**
+         * @brief Change a tensor's shape (e.g. the batch dimension of a
+         * graph input between requests) and mark its consumers for
+         * re-inference by the next shape_infer() call.
+         */
+        void setTensorShape(const Tensor &tensor, const Shape &shape);
+
+        /**
+         * @brief Re-infer shapes incrementally: only ops marked dirty by
+         * setTensorShape are visited (in topological order), and
+         * propagation stops wherever an inferred output shape is unchanged.
+         * A no-op on a clean graph.
+         */
         void shape_infer();
 
-        void dataMalloc();
+        /**
+         * @brief Plan the arena and bind every tensor to its offset. With
+         * materialize=false only the alloc/free simulation runs — no memory
+         * is committed and no tensor is bound — so the allocator's
+         * getPeakBytes() reports what a real dataMalloc() would need; see
+         * pickChunkBatch().
+         */
+        void dataMalloc(bool materialize = true);
+
+        /**
+         * @brief Prefault the arena after dataMalloc() and, when dummyRun
+         * is set, execute every kernel once to warm code and data caches,
+         * so the first real inference pays no cold-start cost. Returns the
+         * milliseconds spent; a replica can report warm once this returns.
+         */
+        double warmup(bool dummyRun = true);
+
+        /**
+         * @brief Compile the graph into an immutable execution plan with
+         * pre-resolved kernels and data pointers. Requires topo_sort() to
+         * succeed and every tensor to have bound data, i.e. call it after
+         * dataMalloc().
+         */
+        ExecutionPlan compile();
+
+        /**
+         * @brief Streaming execution: run the graph in dim-0 slices of at
+         * most chunkBatch rows, so the intermediate arena is planned for a
+         * sub-batch instead of the full input. The batch is dim 0 of the
+         * graph outputs (which must agree on it); every sourceless tensor
+         * whose leading dim equals it is sliced, the rest (weights) are
+         * shared with the chunk graph by refcount. Callers bind full-batch
+         * inputs beforehand (e.g. setData over their own buffers); outputs
+         * without bound data get storage from this graph's arena and hold
+         * the concatenated result afterwards. A trailing partial chunk is
+         * handled by shrinking the chunk graph's batch in place.
+         */
+        void runChunked(int chunkBatch);
+
+        /**
+         * @brief The largest power-of-two chunk (capped at the full batch)
+         * whose planned activation arena fits budgetBytes, found by costing
+         * throwaway chunk clones with dataMalloc(false). Weights do not
+         * count against the budget — they are shared, not copied. Asserts
+         * if even a single-row arena exceeds the budget.
+         */
+        int pickChunkBatch(size_t budgetBytes) const;
+
+        /**
+         * @brief Per-op roofline table combining getFlops()/getBytes()
+         * with the runtime profiler's timings: arithmetic intensity and
+         * achieved GFLOP/s and GB/s per op, plus — when the machine peaks
+         * are given — the percent of peak and whether the op is compute-
+         * or bandwidth-bound. Run the graph with profiling enabled first;
+         * ops without samples show their counters only.
+         */
+        std::string rooflineReport(double peakGflops = 0,
+                                   double peakGBps = 0) const;
+
+        /**
+         * @brief Dump every tensor with bound data to
+         * `<dir>/tensor_<fuid>.itsr` (see TensorObj::dumpTo), capturing a
+         * run's intermediate activations for offline accuracy debugging.
+         * Returns the number of tensors written.
+         */
+        size_t dumpTensors(const std::string &dir) const;
+
+        /**
+         * @brief Serialize the graph to a binary model file: a graph
+         * section (ops, attributes, tensor shapes/dtypes, connectivity by
+         * fuid) followed by a page-aligned weight section holding every
+         * tensor with bound data. See load() for the zero-copy read side.
+         */
+        void save(const std::string &path) const;
+
+        /**
+         * @brief Rebuild a graph from a file written by save(). The weight
+         * section is mmap'ed read-only and tensors are bound straight into
+         * the mapping — no copy, demand-paged, and the pages are shared
+         * across replica processes loading the same file. The mapping
+         * lives as long as the graph does.
+         */
+        static Graph load(Runtime runtime, const std::string &path);
 
         /**
          * @brief Add an operator and create its outputs. Output tensor arguments
@@ -64,7 +183,11 @@ namespace infini
         template <typename T, typename... Args>
         Ref<T> addOp(Args &&...args)
         {
-            Ref<T> op = infini::make_ref<T>(this, std::forward<Args>(args)...);
+            // drawn from the graph's object pool: thousands of ops cost a
+            // handful of chunk allocations instead of one malloc each
+            Ref<T> op = std::allocate_shared<T>(PoolAllocator<T>(objectPool),
+                                                this,
+                                                std::forward<Args>(args)...);
             addOperatorAndConnect(op);
             return op;
         }
@@ -75,7 +198,9 @@ namespace infini
         template <typename T, typename... Args>
         Ref<T> addOpWithOutputs(Args &&...args)
         {
-            Ref<T> op = infini::make_ref<T>(nullptr, std::forward<Args>(args)...);
+            Ref<T> op = std::allocate_shared<T>(PoolAllocator<T>(objectPool),
+                                                nullptr,
+                                                std::forward<Args>(args)...);
             addOperatorAndConnect(op);
             return op;
         }
@@ -106,6 +231,15 @@ namespace infini
 
         bool checkValid() const;
 
+        /**
+         * @brief Snapshot the graph in linear time: operators and
+         * connectivity are duplicated, sourceless tensors (inputs and
+         * weights) share their payload with the original, and computed
+         * tensors get storage from the clone's own dataMalloc(). Lets
+         * tooling try a rewrite on the copy and roll back by discarding it.
+         */
+        Graph clone() const;
+
     private:
         /**
          * @brief Add reverse connections and Op relationship in ctor.
@@ -113,17 +247,69 @@ namespace infini
         void addOperatorAndConnect(const Operator &op);
 
         /**
-         * @brief Remove redundant transpose operators that are inverse of each other.
-         * @return true if any optimization was performed, false otherwise.
+         * @brief A local rewrite rule, invoked by optimize() for ops whose
+         * OpType it is registered for. Returns true if it rewrote the graph
+         * around `op`; ops whose patterns may have been (in)validated by the
+         * rewrite are appended to `affected` so the worklist can revisit
+         * them.
+         */
+        using RewriteRule = bool (GraphObj::*)(const Operator &op,
+                                               OpVec &affected);
+
+        /**
+         * @brief Evaluate an op whose inputs are all sourceless constants
+         * with bound data once through its CPU kernel, leaving its output as
+         * a precomputed constant. Applies to every OpType, so optimize()
+         * tries it before the keyed rules.
+         */
+         bool rewriteFoldConstant(const Operator &op, OpVec &affected);
+
+        /**
+         * @brief Remove a transpose pair that are inverse of each other,
+         * reconnecting the first one's input to the pair's consumers.
          */
-         bool removeRedundantTranspose();
+         bool rewriteTransposePair(const Operator &op, OpVec &affected);
 
          /**
-          * @brief Fuse transpose operations into matmul operators by setting transA/transB flags.
-          * @return true if any optimization was performed, false otherwise.
+          * @brief Fuse a last-two-dim transpose feeding this matmul into its
+          * transA/transB attributes. A transpose with other users is kept
+          * (DCE can collect it later if it becomes dead).
           */
-         bool fuseTransposeIntoMatmul();
- 
+         bool rewriteTransposeIntoMatmul(const Operator &op, OpVec &affected);
+
+         /**
+          * @brief Push symmetric per-tensor quantization through a matmul:
+          * MatMul(DequantizeLinear(qA), DequantizeLinear(qB)) becomes an
+          * int8 MatMul with an Int32 accumulator followed by a single
+          * DequantizeLinear with the product of the two scales. Exact up to
+          * fp32 rounding, so it is safe as an optimize() rule; dequantizes
+          * with other users are kept.
+          */
+         bool rewriteQuantizedMatmul(const Operator &op, OpVec &affected);
+
+         /**
+          * @brief Fuse a binary elementwise op with its single Relu/Clip
+          * consumer into a FusedElemAct operator, dropping the intermediate
+          * tensor.
+          */
+         bool rewriteElementWiseActivation(const Operator &op, OpVec &affected);
+
+         /**
+          * @brief Merge ops with the same OpType, inputs and attributes so
+          * each distinct expression is computed once. Processes ops in
+          * topological order, so merges cascade downstream in one pass.
+          * @return true if any duplicate was merged.
+          */
+         bool eliminateCommonSubexpr();
+
+         /**
+          * @brief Remove ops (and their now-unreferenced tensors) that no
+          * graph output depends on, found by a backward walk from the output
+          * tensors.
+          * @return true if anything was removed.
+          */
+         bool eliminateDeadCode();
+
          /**
           * @brief Check if two permutation vectors are inverse of each other.
           * @param perm1 First permutation vector
@@ -139,26 +325,74 @@ namespace infini
           * @return true if it's a last-two-dimension transpose
           */
          bool isLastTwoDimTranspose(const std::vector<int>& permute, int rank);
- 
+
          /**
-          * @brief Reconnect tensors by redirecting all targets from one tensor to another.
-          * @param from Source tensor
-          * @param to Target tensor
+          * @brief The input of `op` that its output `output` may be written
+          * over in place: same shape and byte size, read only by this op,
+          * and not a graph input, weight or constant. Returns nullptr when
+          * the op cannot run in place.
           */
-         void reconnectTensors(Tensor from, Tensor to);
- 
+         Tensor inplaceInputOf(const Operator &op, const Tensor &output) const;
+
+         /**
+          * @brief Follow Reshape/Flatten/Identity source chains — and
+          * in-place-eligible elementwise ops, see inplaceInputOf — to the
+          * tensor whose storage `tensor` aliases; returns the tensor itself
+          * when it owns its bytes. dataMalloc (and the lifetime planner)
+          * rely on this so alias ops never allocate or copy.
+          */
+         Tensor aliasRootOf(const Tensor &tensor) const;
+
          /**
-          * @brief Replace an operator in the graph with a new operator.
-          * @param oldOp The operator to be replaced
-          * @param newOp The new operator to replace with
+          * @brief The clone runChunked/pickChunkBatch execute per chunk:
+          * sourceless tensors with leading dim fullBatch are resized to
+          * chunkBatch and unbound (so dataMalloc gives them chunk-sized
+          * storage), everything else keeps sharing the original's payload.
           */
-         void replaceOperator(Operator oldOp, Operator newOp);
+         Graph makeChunkGraph(int fullBatch, int chunkBatch) const;
+
+         /**
+          * @brief Dim 0 shared by every graph output — the batch axis
+          * runChunked slices. Asserts when outputs disagree or are rank 0.
+          */
+         int chunkedBatchSize() const;
 
          bool removeOperatorfromGraph(Operator op);
         /**
          * @brief If the nodes is sorted in topological order.
          */
         bool sorted;
+
+        /**
+         * @brief Indexes kept in sync by addTensor/addOperatorAndConnect/
+         * remove*, so lookup, membership tests and checkValid() cost O(1)
+         * per element instead of scanning the vectors. optimize() also uses
+         * opIndex to skip worklist entries whose op was removed by an
+         * earlier rewrite while still being kept alive by an outside
+         * reference.
+         */
+        std::unordered_map<UidBaseType, Operator> opIndex;  // guid -> op
+        std::unordered_map<UidBaseType, Tensor> fuidIndex;  // fuid -> tensor
+        std::unordered_set<TensorObj *> tensorSet;
+
+        /**
+         * @brief Ops whose input shapes changed since the last
+         * shape_infer(); the dirty region it propagates from.
+         */
+        std::unordered_set<OperatorObj *> shapeDirty;
+
+        /**
+         * @brief Pool the graph's tensors and operators are allocated
+         * from; freed wholesale when the last object (or the graph) lets
+         * go of it.
+         */
+        ObjectPool objectPool = make_ref<ObjectPoolObj>();
+
+        /**
+         * @brief Keeps the weight mapping of a load()ed model alive (and
+         * unmapped on destruction) while tensors point into it.
+         */
+        std::shared_ptr<void> weightMapping;
     };
 
 } // namespace infini
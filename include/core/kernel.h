@@ -4,12 +4,22 @@
 #include "core/tensor.h"
 #include "utils/operator_utils.h"
 #include <functional>
+#include <mutex>
 
 namespace infini
 {
 
     class RuntimeObj;
 
+    /**
+     * @brief A plan-time resolved kernel entry point: one fully
+     * specialized template instantiation (dtype, optype, ...), so the
+     * per-run dispatch is a single indirect call and the inner compute
+     * functions are inlined into the body behind it.
+     */
+    using SpecializedCompute = void (*)(const Operator &op,
+                                        const RuntimeObj *context);
+
     class Kernel
     {
     public:
@@ -18,9 +28,40 @@ namespace infini
 
         /**
          * @brief Executes an op with a default parameter.
+         *
+         * compute is const and must stay stateless: one kernel instance
+         * serves every graph in the process, possibly from several
+         * threads at once, so any scratch state belongs on the stack (or
+         * in thread_local storage), never in the kernel object.
          */
         virtual void compute(const Operator &op,
                              const RuntimeObj *context) const = 0;
+
+        /**
+         * @brief The specialized entry point serving `op`, or nullptr
+         * when the kernel only has the generic compute(). A tensor's
+         * dtype (and an op's type) never changes after graph
+         * construction, so GraphObj::compile() resolves this once per op
+         * and stores the pointer in the plan instead of re-running the
+         * dtype/optype switches on every invocation.
+         */
+        virtual SpecializedCompute specialize(const Operator &op) const
+        {
+            return nullptr;
+        }
+
+        /**
+         * @brief One-time plan-time preparation for `op` — e.g. packing a
+         * constant weight operand into the kernel's blocked layout so runs
+         * skip the per-call repack. GraphObj::compile() calls this after
+         * kernel selection; the default does nothing.
+         */
+        virtual void prepack(const Operator &op,
+                             const RuntimeObj *context) const
+        {
+            (void)op;
+            (void)context;
+        }
     };
 
     class KernelRegistry
@@ -30,14 +71,22 @@ namespace infini
             tuple<Kernel *const, const string, const int>; // Kernel, name, ID
 
     private:
-        std::map<KernelAttrs, KernelRecord> kernels;
+        // several candidates may share a key (e.g. a naive fallback and a
+        // tiled variant); the first registered one is the default, and the
+        // PerfEngine picks between them by measurement
+        std::map<KernelAttrs, std::vector<KernelRecord>> kernels;
         int nKernels = 0;
+        // guards registration only: the registry is immutable once static
+        // initialization (all REGISTER_KERNEL sites) has run, so lookups
+        // from concurrently running graphs read it without locking
+        std::mutex registerMtx;
 
     public:
         ~KernelRegistry()
         {
             for (auto &[k, v] : kernels)
-                delete std::get<0>(v);
+                for (auto &record : v)
+                    delete std::get<0>(record);
         }
         static KernelRegistry &getInstance()
         {
@@ -46,22 +95,30 @@ namespace infini
         }
         bool registerKernel(const KernelAttrs &key, Kernel *kernel, string name)
         {
-            IT_ASSERT(kernels.find(key) == kernels.end(),
-                      "Kernel already registered");
-            kernels.emplace(key, KernelRecord{kernel, name, ++nKernels});
+            std::lock_guard<std::mutex> lock(registerMtx);
+            kernels[key].emplace_back(kernel, name, ++nKernels);
             return true;
         }
         Kernel *getKernel(const KernelAttrs &kernelAttrs) const
         {
-            auto it = kernels.find(kernelAttrs);
-            IT_ASSERT(it != kernels.end(), "Kernel not found for key {" +
-                                               get_kernel_attrs_str(kernelAttrs) +
-                                               "}");
-            return std::get<0>(it->second);
+            return std::get<0>(getKernelItem(kernelAttrs));
         }
         const KernelRecord &getKernelItem(const KernelAttrs &kernelAttrs) const
         {
-            return kernels.at(kernelAttrs);
+            return getCandidates(kernelAttrs).front();
+        }
+        bool hasKernel(const KernelAttrs &kernelAttrs) const
+        {
+            return kernels.count(kernelAttrs) > 0;
+        }
+        const std::vector<KernelRecord> &
+        getCandidates(const KernelAttrs &kernelAttrs) const
+        {
+            auto it = kernels.find(kernelAttrs);
+            IT_ASSERT(it != kernels.end() && !it->second.empty(),
+                      "Kernel not found for key {" +
+                          get_kernel_attrs_str(kernelAttrs) + "}");
+            return it->second;
         }
     };
 
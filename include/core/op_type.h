@@ -24,6 +24,14 @@ namespace infini
             Relu,
             Sub,
             Transpose,
+            // Internal fused op produced by GraphObj::optimize; keep appended
+            // so the underlying values of the ONNX-style ops stay stable.
+            FusedElemAct,
+            Reshape,
+            Flatten,
+            Identity,
+            QuantizeLinear,
+            DequantizeLinear,
 
         } type;
 
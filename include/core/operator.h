@@ -55,6 +55,40 @@ namespace infini
         virtual int numInputs() const = 0;
         virtual int numOutputs() const = 0;
 
+        /**
+         * @brief Floating-point operations this op performs, for the
+         * roofline report. Pure byte movers (transpose, concat, reshape)
+         * keep the default 0; compute ops override it.
+         */
+        virtual size_t getFlops() const { return 0; }
+
+        /**
+         * @brief Bytes this op moves: every input read once plus every
+         * output written once. Ops with a different traffic pattern
+         * override it.
+         */
+        virtual size_t getBytes() const
+        {
+            size_t bytes = 0;
+            for (const auto &input : inputs)
+                bytes += input->getBytes();
+            for (const auto &output : outputs)
+                bytes += output->getBytes();
+            return bytes;
+        }
+
+        /**
+         * @brief The attributes that, together with the OpType and the input
+         * tensors, fully determine this operator's result. Two ops with equal
+         * attr vectors, OpType and inputs compute the same value; common
+         * subexpression elimination relies on this. Operators with extra
+         * attributes must override it.
+         */
+        virtual vector<int> getOpAttrVector() const
+        {
+            return {type.underlying()};
+        }
+
         /**
          * @brief Clone this operator and replace its inputs and outputs.
          *
@@ -0,0 +1,62 @@
+#pragma once
+#include "core/kernel.h"
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief Picks between the kernel candidates registered for a
+     * (Device, OpType) key by measurement. The first time an op with a
+     * given (device, op type, dtype, input shapes) signature is executed,
+     * every candidate is timed on the op's real buffers and the fastest
+     * one is cached; later ops with the same signature hit the cache.
+     * The cache can be saved to and reloaded from a file, so a deployment
+     * tunes once rather than on every start.
+     */
+    class PerfEngine
+    {
+        struct Entry
+        {
+            Kernel *kernel;
+            std::string kernelName;
+            double timeMs; // best candidate's measured time; 0 if untimed
+        };
+
+        std::map<std::string, Entry> best; // signature -> winner
+        mutable std::mutex mtx;
+
+        PerfEngine() = default;
+
+      public:
+        static PerfEngine &getInstance()
+        {
+            static PerfEngine instance;
+            return instance;
+        }
+
+        /**
+         * @brief The kernel to run `op` with: the cached winner for its
+         * signature, or — on a cache miss with several candidates and data
+         * bound — the winner of timing each candidate once now. Falls back
+         * to the default (first registered) kernel when the op's tensors
+         * have no data yet, without polluting the cache.
+         */
+        Kernel *getBestKernel(const Operator &op, const RuntimeObj *context);
+
+        /** @brief The tuning key; see the class comment for its parts. */
+        static std::string signatureOf(Device device, const Operator &op);
+
+        /** @brief One "signature kernel_name time_ms" line per entry. */
+        bool save(const std::string &path) const;
+
+        /**
+         * @brief Merge entries from a save() file, resolving kernel names
+         * against the current registry; unknown names are skipped.
+         */
+        bool load(const std::string &path);
+
+        void clear();
+        size_t size() const;
+    };
+
+} // namespace infini
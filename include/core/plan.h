@@ -0,0 +1,61 @@
+#pragma once
+#include "core/kernel.h"
+#include "core/operator.h"
+
+namespace infini
+{
+    /**
+     * @brief One pre-resolved execution step. The kernel is looked up in the
+     * registry and the tensor data pointers are fetched once at compile
+     * time, so the run loop dispatches without per-op map lookups and
+     * downstream executors can reach the data without shared-pointer
+     * traversal.
+     */
+    struct PlanStep
+    {
+        const Kernel *kernel;
+        // the dtype/optype-specialized instantiation resolved at compile
+        // time (see Kernel::specialize); nullptr falls back to the
+        // kernel's generic compute()
+        SpecializedCompute fn = nullptr;
+        Operator op; // owning ref: keeps the op and its tensors alive
+        vector<void *> inputData;
+        vector<void *> outputData;
+    };
+
+    /**
+     * @brief An immutable execution plan compiled from a graph by
+     * GraphObj::compile(): a flat array of steps in topological order plus
+     * CSR successor lists over step indices, so dependency-driven executors
+     * traverse raw indices instead of locking WRefs. The plan caches data
+     * pointers, so it must be recompiled after dataMalloc() is rerun.
+     */
+    class ExecutionPlanObj
+    {
+        friend class GraphObj;
+
+        vector<PlanStep> steps;
+        // successors of step i are succSteps[succOffsets[i]..succOffsets[i+1])
+        vector<int> succOffsets;
+        vector<int> succSteps;
+        // in-edge count per step (duplicate edges counted), the initial
+        // value of a dependency-counting executor's per-step counter
+        vector<int> predCounts;
+
+    public:
+        ExecutionPlanObj() = default;
+
+        const vector<PlanStep> &getSteps() const { return steps; }
+        size_t numSteps() const { return steps.size(); }
+        const int *successorsBegin(int step) const
+        {
+            return succSteps.data() + succOffsets[step];
+        }
+        const int *successorsEnd(int step) const
+        {
+            return succSteps.data() + succOffsets[step + 1];
+        }
+        int predecessorCount(int step) const { return predCounts[step]; }
+    };
+
+} // namespace infini
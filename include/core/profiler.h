@@ -0,0 +1,77 @@
+#pragma once
+#include "core/object.h"
+#include <map>
+#include <mutex>
+
+namespace infini
+{
+    class OperatorObj;
+
+    /**
+     * @brief Per-operator wall-time collector owned by the runtime. Kernels
+     * are timed only while profiling is enabled on the runtime (a single
+     * branch per op otherwise); samples are keyed by op guid and labelled
+     * with the OpType, so repeated runs of the same graph accumulate per-op
+     * invocation counts and min/mean/p99 latencies. Reports dump as CSV or
+     * JSON, optionally automatically every N runs.
+     */
+    class Profiler
+    {
+        struct Record
+        {
+            std::string opType;
+            std::vector<double> samplesMs;
+        };
+
+        // guid -> samples; map keeps the report ordered by creation order
+        std::map<UidBaseType, Record> records;
+        mutable std::mutex mtx;
+        uint64_t runs = 0;
+        uint64_t dumpEvery = 0;
+        std::string dumpPath;
+
+      public:
+        /**
+         * @brief Aggregated view of one op's samples, as reported in the
+         * CSV/JSON dumps and consumed by the roofline report.
+         */
+        struct OpStat
+        {
+            std::string opType;
+            size_t count;
+            double minMs, meanMs, p99Ms;
+        };
+
+        /**
+         * @brief Append one kernel invocation. Thread-safe, so the parallel
+         * executor's workers can record concurrently.
+         */
+        void record(const Ref<OperatorObj> &op, double ms);
+
+        /** @brief Per-op aggregates keyed by guid. */
+        std::map<UidBaseType, OpStat> aggregate() const;
+
+        /**
+         * @brief Mark the end of one graph/plan execution; when an auto-dump
+         * is configured, writes the report every N runs.
+         */
+        void endRun();
+
+        /**
+         * @brief Write the report to `path` after every `everyNRuns`
+         * executions. A path ending in ".json" selects JSON, anything else
+         * CSV. Pass 0 to turn auto-dumping off.
+         */
+        void setAutoDump(uint64_t everyNRuns, const std::string &path);
+
+        void clear();
+
+        uint64_t numRuns() const;
+
+        /** @brief One line per op: guid,op_type,count,min_ms,mean_ms,p99_ms. */
+        std::string toCsv() const;
+        /** @brief The same report as a JSON array of objects. */
+        std::string toJson() const;
+    };
+
+} // namespace infini
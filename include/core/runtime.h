@@ -1,7 +1,10 @@
 #pragma once
 #include "core/common.h"
 #include "core/op_type.h"
+#include "core/profiler.h"
 #include "core/ref.h"
+#include "utils/thread_pool.h"
+#include <future>
 
 namespace infini
 {
@@ -10,12 +13,14 @@ namespace infini
   class GraphObj;
   class RuntimeObj;
   class BlobObj;
+  class ExecutionPlanObj;
 
   using Tensor = Ref<TensorObj>;
   using Operator = Ref<OperatorObj>;
   using Graph = Ref<GraphObj>;
   using Runtime = Ref<RuntimeObj>;
   using Blob = Ref<BlobObj>;
+  using ExecutionPlan = Ref<ExecutionPlanObj>;
 
   using TensorVec = vector<Tensor>;
   using OpVec = vector<Operator>;
@@ -25,6 +30,43 @@ namespace infini
     CPU = 1
   };
 
+  /**
+   * @brief How runtime allocations commit their pages.
+   * - Zeroed: calloc, single-threaded zeroing (the historical default).
+   * - Untouched: no zeroing; producers overwrite tensors anyway, so the
+   *   pages fault in lazily on whichever thread writes first.
+   * - FirstTouch: each pool worker zeroes the contiguous slice it will
+   *   later stream in parallelFor, so on NUMA machines the pages land on
+   *   the socket that reads them.
+   * - Interleaved: pages are touched round-robin across the pool workers,
+   *   spreading the arena over all memory controllers (the portable
+   *   stand-in for a libnuma interleave policy).
+   */
+  enum class AllocMode
+  {
+    Zeroed,
+    Untouched,
+    FirstTouch,
+    Interleaved
+  };
+
+  /**
+   * @brief Observability callbacks for the run loops, for exporting
+   * per-layer latencies to an external metrics stack without wrapping
+   * run() or forking the runtime. Plain function pointers with one shared
+   * context pointer: installing none costs a null check per op, and the
+   * hot path never allocates a std::function. Post hooks receive the
+   * elapsed wall time in nanoseconds.
+   */
+  struct ExecutionHooks
+  {
+    void *ctx = nullptr;
+    void (*graphBegin)(void *ctx) = nullptr;
+    void (*graphEnd)(void *ctx, int64_t elapsedNs) = nullptr;
+    void (*preOp)(void *ctx, const Operator &op) = nullptr;
+    void (*postOp)(void *ctx, const Operator &op, int64_t elapsedNs) = nullptr;
+  };
+
   class RuntimeObj : public std::enable_shared_from_this<RuntimeObj>
   {
   protected:
@@ -38,6 +80,24 @@ namespace infini
     virtual ~RuntimeObj() {}
 
     virtual void run(const Graph &graph) const = 0;
+    /**
+     * @brief Execute a compiled plan (see GraphObj::compile): a plain walk
+     * over pre-resolved kernels with no registry lookups on the hot path.
+     */
+    virtual void run(const ExecutionPlan &plan) const = 0;
+    /**
+     * @brief Execute a compiled plan on a fresh thread and return a
+     * completion token, so the caller can stage the next request's inputs
+     * (or do anything else) while the kernels run. Plans share mutable
+     * tensor bindings, so callers serialize runs over the same graph
+     * themselves — SessionObj::runAsync does this for the serving case.
+     */
+    std::future<void> runAsync(const ExecutionPlan &plan) const
+    {
+      return std::async(std::launch::async,
+                        [this, plan] { run(plan); });
+    }
+
     virtual void *alloc(size_t size) = 0;
     virtual void dealloc(void *ptr) = 0;
 
@@ -46,7 +106,31 @@ namespace infini
       return true;
     }
 
+    Device getDevice() const { return device; }
+
+    /**
+     * @brief Toggle per-op wall-time collection in the run loops. Off by
+     * default; when off the only cost is one branch per op. Samples
+     * accumulate across runs until the profiler is cleared.
+     */
+    void setProfiling(bool on) { profiling = on; }
+    bool isProfiling() const { return profiling; }
+    Profiler &getProfiler() const { return profiler; }
+
+    /**
+     * @brief Install (or, with a default-constructed value, remove) the
+     * execution hooks. Not synchronized against concurrent run() calls;
+     * install before running.
+     */
+    void setHooks(const ExecutionHooks &h) { hooks = h; }
+    const ExecutionHooks &getHooks() const { return hooks; }
+
     virtual string toString() const = 0;
+
+  protected:
+    bool profiling = false;
+    mutable Profiler profiler;
+    ExecutionHooks hooks;
   };
 
   class NativeCpuRuntimeObj : public RuntimeObj
@@ -62,8 +146,36 @@ namespace infini
     }
     void dealloc(void *ptr) override;
     void run(const Graph &graph) const override;
+    void run(const ExecutionPlan &plan) const override;
+    /**
+     * @brief Execute a compiled plan with inter-op parallelism: steps whose
+     * predecessor counters reach zero are picked up by the worker pool, so
+     * independent branches overlap. Kernels invoked from the pool run their
+     * own loops inline, which keeps the core count from being oversubscribed.
+     */
+    void runParallel(const ExecutionPlan &plan) const;
     void *alloc(size_t size) override;
     string toString() const override;
+
+    /**
+     * @brief Worker pool shared by all CPU kernels running on this runtime.
+     * Kernels split their loops across it via parallelFor; the thread count
+     * is process-wide configurable through setNumThreads (or the
+     * INFINI_NUM_THREADS environment variable).
+     */
+    ThreadPool &getWorkers() const { return workers; }
+    void setNumThreads(int numThreads) { workers.setNumThreads(numThreads); }
+    void setAllocMode(AllocMode mode) { allocMode = mode; }
+    AllocMode getAllocMode() const { return allocMode; }
+    void parallelFor(size_t n, size_t grainSize,
+                     const std::function<void(size_t, size_t)> &fn) const
+    {
+      workers.parallelFor(n, grainSize, fn);
+    }
+
+  private:
+    mutable ThreadPool workers;
+    AllocMode allocMode = AllocMode::Zeroed;
   };
 
 } // namespace infini
@@ -0,0 +1,113 @@
+#pragma once
+#include "core/graph.h"
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+namespace infini
+{
+    class SessionObj;
+    using Session = Ref<SessionObj>;
+
+    /**
+     * @brief A persistent inference session over one graph: all one-time
+     * work (topological sort, optimization, arena planning, plan
+     * compilation) happens in the constructor, and each request only
+     * rebinds input buffers and walks the compiled plan. Rebinding is
+     * zero-copy when the caller's buffer meets the arena alignment —
+     * the tensor adopts the pointer — and a memcpy into the pre-planned
+     * arena slot otherwise; rebinding the same pointer twice is free.
+     */
+    class SessionObj
+    {
+    public:
+        /**
+         * @brief Take ownership of `graph` and make it servable: sort,
+         * optimize, allocate the arena and compile the plan. With
+         * `parallel` set, requests run through runParallel so independent
+         * branches overlap on the worker pool.
+         */
+        /**
+         * @brief With `pipelined` set the constructor additionally plans
+         * two staging copies of every input in the arena, enabling
+         * runAsync()'s double-buffered ingestion.
+         */
+        explicit SessionObj(Graph graph, bool parallel = false,
+                            bool pipelined = false);
+
+        ~SessionObj();
+
+        const TensorVec &getInputs() const { return inputs; }
+        const TensorVec &getOutputs() const { return outputs; }
+        Graph getGraph() const { return graph; }
+
+        /**
+         * @brief Bind a caller-owned buffer of `bytes` bytes as input `i`
+         * for subsequent runs. The buffer must stay valid until it is
+         * rebound (or the session is destroyed) unless it was copied; the
+         * return value says which happened — true means adopted in place,
+         * false means copied into the arena.
+         */
+        bool bindInput(size_t i, const void *buffer, size_t bytes);
+
+        /**
+         * @brief Execute one request with the current bindings.
+         */
+        void run();
+
+        /**
+         * @brief Bind one buffer per graph input (sizes must match the
+         * input tensors), then execute. The per-request path: no lookups,
+         * no allocation when the buffers are aligned and unchanged.
+         */
+        void run(const std::vector<const void *> &buffers);
+
+        /**
+         * @brief Pipelined request submission (requires a pipelined
+         * session): the inputs are copied into one of the two staging
+         * regions on the calling thread — overlapping the previous
+         * request's compute — and the plan runs asynchronously with the
+         * graph inputs rebound to that region. When `outputBuffers` are
+         * given, the results are copied into them before the returned
+         * token completes, so the caller never races the next request's
+         * compute for the output tensors. At most two requests are in
+         * flight; a third submission blocks until a staging region frees
+         * up. Submit from one thread.
+         */
+        std::shared_future<void>
+        runAsync(const std::vector<const void *> &buffers,
+                 const std::vector<void *> &outputBuffers = {});
+
+        /**
+         * @brief Wait for every in-flight runAsync request.
+         */
+        void sync();
+
+    private:
+        Graph graph;
+        Runtime runtime;
+        ExecutionPlan plan;
+        bool parallel;
+        TensorVec inputs, outputs;
+
+        // per input: the arena-backed blob dataMalloc planned (the copy
+        // destination) and the most recently adopted foreign pointer, so
+        // re-binding an unchanged buffer is a pointer compare
+        std::vector<Blob> arenaBlobs;
+        std::vector<const void *> boundPtrs;
+
+        // double-buffered staging (pipelined sessions only): two arena
+        // regions per input, used round-robin so request N+1 can stage
+        // into one while request N computes out of the other
+        std::vector<Blob> stagingBlobs[2];
+
+        // pipeline state: computes are chained through lastCompute so they
+        // run one at a time in submission order, and inFlight (≤ 2) gates
+        // staging-region reuse
+        std::mutex pipeMutex;
+        std::condition_variable pipeCv;
+        int inFlight = 0;
+        int nextStaging = 0;
+        std::shared_future<void> lastCompute;
+    };
+} // namespace infini
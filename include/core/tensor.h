@@ -3,15 +3,33 @@
 #include "core/data_type.h"
 #include "core/object.h"
 #include "core/runtime.h"
+#include "utils/small_vector.h"
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 
 namespace infini
 {
     class GraphObj;
     using ShapeElem = int;
-    using Shape = vector<ShapeElem>;
+    // inline storage for rank <= 8: shape copies on hot paths (inferShape,
+    // kernels, graph passes) stay off the heap
+    using Shape = SmallVector<ShapeElem, 8>;
+
+    /**
+     * @brief Mismatch statistics from TensorObj::compareData — the
+     * machine-readable counterpart of equalData for validation harnesses.
+     */
+    struct CompareStats
+    {
+        size_t mismatchCount = 0;
+        double maxError = 0; // largest relative error observed
+        size_t firstMismatch = SIZE_MAX; // element index; SIZE_MAX when equal
+    };
+
     class TensorObj : public Object
     {
         friend class GraphObj;
@@ -30,6 +48,18 @@ namespace infini
         size_t _size; // Cache of Π(shape).
         Fuid fuid;    // Cloned tensors share the same id. Tensors constructed from
                       // scratch have a new id.
+        // View state: element strides over `shape` and the element offset
+        // into `viewStorage`'s buffer. Empty strides mean dense row-major
+        // (the normal, non-view case); `viewStorage` is null unless this
+        // tensor was created by slice/narrow/squeeze.
+        Shape strides;
+        size_t viewOffset = 0;
+        Tensor viewStorage;
+        // bumped by every tracked mutation (setData, setDataBlob, loadFrom)
+        // so plan-time derived copies of this tensor's bytes can tell
+        // whether they are still current; raw getRawDataPtr writes are
+        // invisible to it and require a recompile instead
+        mutable uint64_t dataVersion = 0;
 
     public:
         TensorObj(Shape shape, DataType dtype, Runtime runtime);
@@ -39,19 +69,98 @@ namespace infini
         size_t size() const { return _size; }
         size_t getBytes() const { return _size * dtype.getSize(); }
 
-        Shape getDims() const { return shape; }
+        const Shape &getDims() const { return shape; }
         void setShape(Shape shape_);
         size_t getRank() const { return shape.size(); }
         UidBaseType getFuid() const { return fuid; }
 
+        /**
+         * @brief Zero-copy views: the returned tensor aliases `t`'s buffer
+         * at an element offset with explicit strides, so slicing a batch or
+         * splitting attention heads is pointer arithmetic instead of a
+         * materializing op. Views of views collapse to one level. A view in
+         * a graph borrows its storage tensor's bytes from dataMalloc; the
+         * elementwise, unary and matmul kernels consume non-contiguous
+         * views directly, other kernels require isContiguous().
+         */
+        static Tensor slice(const Tensor &t, int dim, int begin, int end);
+        /// slice expressed as (start, length), like torch::narrow
+        static Tensor narrow(const Tensor &t, int dim, int start, int length);
+        /// drop a size-1 dimension
+        static Tensor squeeze(const Tensor &t, int dim);
+
+        bool isView() const { return viewStorage != nullptr; }
+        Tensor getViewStorage() const { return viewStorage; }
+        size_t getViewOffset() const { return viewOffset; }
+        /// element strides, dense row-major unless this is a strided view
+        Shape getStrides() const;
+        /// true when the elements are laid out densely in index order
+        bool isContiguous() const;
+
         void setData(
             std::function<void(void *, size_t, DataType)> const &generator) const;
 
         void setDataBlob(const Blob &blob);
+        Blob getDataBlob() const { return data; }
+
+        /**
+         * @brief Zero-copy initialization: adopt `buffer` (whose lifetime
+         * the caller manages) as this tensor's storage instead of
+         * generating into freshly allocated bytes. `bytes` must match
+         * getBytes().
+         */
+        void setData(void *buffer, size_t bytes);
+
+        bool hasData() const { return data != nullptr; }
+
+        /**
+         * @brief Monotonic counter of tracked mutations to this tensor's
+         * bytes. Consumers that snapshot the payload at compile time (e.g.
+         * a kernel's prepacked weight copy) record the version they saw
+         * and treat a later value as "stale, fall back or repack".
+         */
+        uint64_t getDataVersion() const { return dataVersion; }
+
+        /**
+         * @brief Copy this tensor without graph connectivity. The copy keeps
+         * the same fuid and shares the data blob by refcount, so cloning
+         * costs O(1) regardless of payload size.
+         */
+        Tensor clone() const
+        {
+            auto obj = make_ref<TensorObj>(*this);
+            obj->targets.clear();
+            obj->source.reset();
+            return obj;
+        }
 
         void printData() const;
         bool equalData(const Tensor &rhs, double relativeError = 1e-6) const;
 
+        /**
+         * @brief Full-scan comparison returning mismatch count, max
+         * relative error and first mismatching index instead of a bool,
+         * computed in parallel over the worker pool. Unlike equalData it
+         * never prints and never exits early, so the report is complete.
+         */
+        CompareStats compareData(const Tensor &rhs,
+                                 double relativeError = 1e-6) const;
+
+        /**
+         * @brief Write this tensor to `path` as a small binary header
+         * (shape, dtype, fuid) followed by the raw buffer in one direct
+         * write — cheap enough to capture multi-GB activations in
+         * production, unlike printData's per-element formatting.
+         */
+        void dumpTo(const string &path) const;
+
+        /**
+         * @brief Read a dumpTo file back into this tensor, which must
+         * match its shape and dtype; storage is allocated if none is
+         * bound. The file is mapped rather than streamed where possible.
+         */
+        void loadFrom(const string &path);
+
         template <typename T>
         bool equalData(const vector<T> &dataVector)
         {
@@ -66,7 +175,9 @@ namespace infini
             static_assert(std::is_pointer_v<T>,
                           "Raw data pointer has a type of pointer");
             IT_ASSERT(data != nullptr);
-            return data->getPtr<T>();
+            // views share their storage tensor's blob; the offset is theirs
+            return reinterpret_cast<T>(data->getPtr<char *>() +
+                                       viewOffset * dtype.getSize());
         }
 
         DataType getDType() const { return dtype; }
@@ -111,42 +222,117 @@ namespace infini
             return builder.str();
         }
 
+        // the error metric equalData has always used, factored out so the
+        // comparison loops carry no branches that would block
+        // vectorization: 0 within tolerance, the relative error (or the
+        // absolute difference for integers / values straddling zero)
+        // otherwise
+        template <typename T>
+        static double elemError(T a, T b)
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                return a == b ? 0.0 : std::fabs((double)a - (double)b);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                double diff = std::fabs((double)a - (double)b);
+                double denom = std::max(std::fabs((double)a),
+                                        std::fabs((double)b));
+                return std::min(std::fabs((double)a), std::fabs((double)b)) ==
+                               0.
+                           ? diff
+                           : diff / denom;
+            }
+            else
+            {
+                static_assert(!sizeof(T), "Unsupported data type");
+            }
+        }
+
         template <typename T>
         bool equalDataImpl(const T *a, const T *b, size_t size,
                            double relativeError = 1e-6) const
         {
+            // large tensors are compared block-wise across the worker
+            // pool: each worker scans its contiguous slice and bails out
+            // once any slice has failed, so a mismatch near the front
+            // does not cost a full pass over a multi-GB tensor
+            constexpr size_t parallelThreshold = 1 << 20;
+            if (size >= parallelThreshold)
+            {
+                std::atomic<bool> equal{true};
+                auto cpuRuntime =
+                    static_cast<NativeCpuRuntimeObj *>(runtime.get());
+                cpuRuntime->parallelFor(
+                    size, 1 << 16,
+                    [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            if ((i & 0xFFFF) == 0 &&
+                                !equal.load(std::memory_order_relaxed))
+                                return;
+                            if (elemError(a[i], b[i]) > relativeError)
+                            {
+                                equal.store(false,
+                                            std::memory_order_relaxed);
+                                return;
+                            }
+                        }
+                    });
+                return equal.load();
+            }
             for (size_t i = 0; i < size; ++i)
             {
-                if constexpr (std::is_integral_v<T>)
+                if (elemError(a[i], b[i]) > relativeError)
                 {
-                    if (a[i] != b[i])
-                        return false;
+                    printf("Error on %lu: %f %f\n", i, (double)a[i],
+                           (double)b[i]);
+                    return false;
                 }
-                else if constexpr (std::is_floating_point_v<T>)
+            }
+            return true;
+        }
+
+        template <typename T>
+        CompareStats compareDataImpl(const T *a, const T *b, size_t size,
+                                     double relativeError) const
+        {
+            CompareStats stats;
+            std::mutex merge;
+            auto cpuRuntime =
+                static_cast<NativeCpuRuntimeObj *>(runtime.get());
+            cpuRuntime->parallelFor(
+                size, 1 << 14,
+                [&](size_t begin, size_t end)
                 {
-                    if (std::min(fabs(a[i]), fabs(b[i])) == 0. &&
-                        fabs(a[i] - b[i]) > relativeError)
-                    {
-                        printf("Error on %lu: %f %f\n", i, a[i], b[i]);
-                        return false;
-                    }
-                    else if (std::min(fabs(a[i]), fabs(b[i])) != 0. &&
-                             fabs(a[i] - b[i]) /
-                                     std::max(fabs(a[i]), fabs(b[i])) >
-                                 relativeError)
+                    CompareStats local;
+                    for (size_t i = begin; i < end; ++i)
                     {
-                        printf("Error on %lu: %f %f\n", i, a[i], b[i]);
-                        return false;
+                        double err = elemError(a[i], b[i]);
+                        if (err > relativeError)
+                        {
+                            ++local.mismatchCount;
+                            local.maxError = std::max(local.maxError, err);
+                            if (local.firstMismatch == SIZE_MAX)
+                                local.firstMismatch = i;
+                        }
                     }
-                }
-                else
-                {
-                    static_assert(!sizeof(T), "Unsupported data type");
-                }
-            }
-            return true;
+                    if (local.mismatchCount == 0)
+                        return;
+                    std::lock_guard<std::mutex> lock(merge);
+                    stats.mismatchCount += local.mismatchCount;
+                    stats.maxError = std::max(stats.maxError, local.maxError);
+                    stats.firstMismatch =
+                        std::min(stats.firstMismatch, local.firstMismatch);
+                });
+            return stats;
         }
 
+        static Tensor makeView(const Tensor &t, Shape shape, Shape strides,
+                               size_t offset);
+
         void addTarget(const Operator &op) { targets.emplace_back(op); }
         void setSource(const Operator &op) { source = op; }
         void removeTarget(const Operator &op)
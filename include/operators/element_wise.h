@@ -28,8 +28,55 @@ namespace infini
     std::string toString() const override;
     int numInputs() const override { return 2; }
     int numOutputs() const override { return 1; }
+
+    // one arithmetic op per output element
+    size_t getFlops() const override { return getOutput()->size(); }
     };
 
+  /**
+   * @brief A binary element-wise op fused with a following activation
+   * (Relu or Clip). Produced by GraphObj::optimize from producer/consumer
+   * chains like Add->Relu so the intermediate tensor is never materialized.
+   */
+  class FusedElemActObj : public OperatorObj
+  {
+  public:
+    /**
+     * @brief Construct a new FusedElemAct object.
+     *
+     * @param graph The computation graph that this operator belongs to.
+     * @param elemType The binary op (Add/Sub/Mul/Div).
+     * @param actType The activation applied to its result (Relu/Clip).
+     * @param input0 The first input tensor.
+     * @param input1 The second input tensor.
+     * @param output The output tensor.
+     * @param min Lower clip bound when actType is Clip.
+     * @param max Upper clip bound when actType is Clip.
+     */
+    FusedElemActObj(GraphObj *graph, OpType elemType, OpType actType,
+                    Tensor input0, Tensor input1, Tensor output,
+                    std::optional<float> min = std::nullopt,
+                    std::optional<float> max = std::nullopt);
+    OP_CLONE(FusedElemActObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+    std::string toString() const override;
+    OpType getElemType() const { return elemType; }
+    OpType getActType() const { return actType; }
+    std::optional<float> getMin() const { return minValue; }
+    std::optional<float> getMax() const { return maxValue; }
+    vector<int> getOpAttrVector() const override;
+    int numInputs() const override { return 2; }
+    int numOutputs() const override { return 1; }
+
+    // the binary op plus the fused activation per output element
+    size_t getFlops() const override { return 2 * getOutput()->size(); }
+
+  private:
+    OpType elemType, actType;
+    std::optional<float> minValue, maxValue;
+  };
+
 #define DEFINE_ELEMENT_WISE_OBJ(prefix, type)                    \
   class prefix##Obj : public ElementWiseObj                      \
   {                                                              \
@@ -44,17 +44,31 @@ namespace infini
 
         std::string toString() const override;
         optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+        // Int8 operands accumulate into an Int32 output; every other dtype
+        // keeps the default input-equals-output rule.
+        vector<DataType> inferDataType(const TensorVec &inputs) const override;
 
         int numInputs() const override { return inputs.size(); }
         int numOutputs() const override { return 1; }
 
         bool getTransA() const { return transA; }
         bool getTransB() const { return transB; }
+        vector<int> getOpAttrVector() const override
+        {
+            return {type.underlying(), transA, transB};
+        }
         void setTransA(bool transA) { this->transA = transA; }
         void setTransB(bool transB) { this->transB = transB; }
         int getM() const { return m; }
         int getN() const { return n; }
         int getK() const { return k; }
+
+        // one multiply and one add per (m, n, k) cell, times the batch
+        size_t getFlops() const override
+        {
+            size_t batch = getOutput()->size() / ((size_t)m * n);
+            return 2 * batch * (size_t)m * n * k;
+        }
     };
 
 } // namespace infini
\ No newline at end of file
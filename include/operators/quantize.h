@@ -0,0 +1,65 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini
+{
+  /**
+   * @brief Quantize a float32 tensor to int8 with a per-tensor affine
+   * mapping: q = clamp(round(x / scale) + zeroPoint, -128, 127).
+   * `scale` and `zeroPoint` are operator attributes rather than input
+   * tensors, matching how Clip carries its bounds.
+   */
+  class QuantizeLinearObj : public OperatorObj
+  {
+  public:
+    QuantizeLinearObj(GraphObj *graph, Tensor input, Tensor output,
+                      float scale, int zeroPoint = 0);
+    OP_CLONE(QuantizeLinearObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    vector<DataType> inferDataType(const TensorVec &inputs) const override;
+
+    std::string toString() const override;
+    float getScale() const { return scale; }
+    int getZeroPoint() const { return zeroPoint; }
+    vector<int> getOpAttrVector() const override;
+    int numInputs() const override { return 1; }
+    int numOutputs() const override { return 1; }
+
+    // a divide, a round and a clamp per output element
+    size_t getFlops() const override { return 3 * getOutput()->size(); }
+
+  private:
+    float scale;
+    int zeroPoint;
+  };
+
+  /**
+   * @brief Map a quantized tensor back to float32:
+   * x = (q - zeroPoint) * scale. Accepts Int8 activations/weights and the
+   * Int32 accumulators an int8 MatMul produces.
+   */
+  class DequantizeLinearObj : public OperatorObj
+  {
+  public:
+    DequantizeLinearObj(GraphObj *graph, Tensor input, Tensor output,
+                        float scale, int zeroPoint = 0);
+    OP_CLONE(DequantizeLinearObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+    vector<DataType> inferDataType(const TensorVec &inputs) const override;
+
+    std::string toString() const override;
+    float getScale() const { return scale; }
+    int getZeroPoint() const { return zeroPoint; }
+    vector<int> getOpAttrVector() const override;
+    int numInputs() const override { return 1; }
+    int numOutputs() const override { return 1; }
+
+    // a subtract and a multiply per output element
+    size_t getFlops() const override { return 2 * getOutput()->size(); }
+
+  private:
+    float scale;
+    int zeroPoint;
+  };
+
+} // namespace infini
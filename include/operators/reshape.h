@@ -0,0 +1,97 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini
+{
+  /**
+   * @brief Reinterpret the input under a new shape with the same number of
+   * elements. The bytes are untouched: dataMalloc aliases the output onto
+   * the input's storage, so the op costs nothing at run time.
+   *
+   */
+  class ReshapeObj : public OperatorObj
+  {
+    Shape dims;
+
+  public:
+    /**
+     * @brief Construct a new Reshape object.
+     *
+     * @param graph The computation graph that this operator belongs to.
+     * @param input The input tensor.
+     * @param output The output tensor.
+     * @param dims The target shape; at most one entry may be -1, which is
+     * inferred from the remaining dimensions.
+     */
+    ReshapeObj(GraphObj *graph, Tensor input, Tensor output, Shape dims);
+    OP_CLONE(ReshapeObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+    std::string toString() const override;
+    int numInputs() const override { return 1; }
+    int numOutputs() const override { return 1; }
+    Shape getDims() const { return dims; }
+    vector<int> getOpAttrVector() const override
+    {
+      vector<int> attrs{type.underlying()};
+      attrs.insert(attrs.end(), dims.begin(), dims.end());
+      return attrs;
+    }
+  };
+
+  /**
+   * @brief Collapse the input into a matrix: dimensions before `axis` become
+   * the rows and the rest become the columns. Aliased like Reshape.
+   *
+   */
+  class FlattenObj : public OperatorObj
+  {
+    int axis;
+
+  public:
+    /**
+     * @brief Construct a new Flatten object.
+     *
+     * @param graph The computation graph that this operator belongs to.
+     * @param input The input tensor.
+     * @param output The output tensor.
+     * @param axis The dimension the column block starts at; may be negative.
+     */
+    FlattenObj(GraphObj *graph, Tensor input, Tensor output, int axis);
+    OP_CLONE(FlattenObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+    std::string toString() const override;
+    int numInputs() const override { return 1; }
+    int numOutputs() const override { return 1; }
+    int getAxis() const { return axis; }
+    vector<int> getOpAttrVector() const override
+    {
+      return {type.underlying(), axis};
+    }
+  };
+
+  /**
+   * @brief Forward the input unchanged. Aliased like Reshape, so it is a
+   * pure graph-plumbing node.
+   *
+   */
+  class IdentityObj : public OperatorObj
+  {
+  public:
+    /**
+     * @brief Construct a new Identity object.
+     *
+     * @param graph The computation graph that this operator belongs to.
+     * @param input The input tensor.
+     * @param output The output tensor.
+     */
+    IdentityObj(GraphObj *graph, Tensor input, Tensor output);
+    OP_CLONE(IdentityObj);
+    optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+    std::string toString() const override;
+    int numInputs() const override { return 1; }
+    int numOutputs() const override { return 1; }
+  };
+} // namespace infini
@@ -27,6 +27,13 @@ namespace infini
     int numInputs() const override { return 1; }
     int numOutputs() const override { return 1; }
     std::vector<int> getPermute() const { return transposePermute; }
+    vector<int> getOpAttrVector() const override
+    {
+        vector<int> attrs{type.underlying()};
+        attrs.insert(attrs.end(), transposePermute.begin(),
+                     transposePermute.end());
+        return attrs;
+    }
 
   private:
     vector<int> transposePermute;
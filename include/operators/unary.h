@@ -24,6 +24,9 @@ namespace infini
     std::string toString() const override;
     int numInputs() const override { return 1; }
     int numOutputs() const override { return 1; }
+
+    // one arithmetic op per output element
+    size_t getFlops() const override { return getOutput()->size(); }
   };
 
   class ClipObj : public OperatorObj
@@ -37,9 +40,13 @@ namespace infini
     std::string toString() const override;
     std::optional<float> getMin() const { return minValue; };
     std::optional<float> getMax() const { return maxValue; };
+    vector<int> getOpAttrVector() const override;
     int numInputs() const override { return 1; }
     int numOutputs() const override { return 1; }
 
+    // a min and a max per output element
+    size_t getFlops() const override { return 2 * getOutput()->size(); }
+
   private:
     std::optional<float> minValue, maxValue;
   };
@@ -84,6 +91,10 @@ namespace infini
     std::string toString() const override;
     CastType getType() const { return castType; }
     DataType getOutputDataType() const;
+    vector<int> getOpAttrVector() const override
+    {
+      return {type.underlying(), (int)castType};
+    }
     int numInputs() const override { return 1; }
     int numOutputs() const override { return 1; }
 
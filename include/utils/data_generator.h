@@ -1,9 +1,17 @@
 #pragma once
 #include "core/common.h"
+#include "core/runtime.h"
+#include <cstring>
 #include <random>
 
 namespace infini {
 
+// chunk a fill across the CPU worker pool; the grain keeps small fills on
+// the calling thread
+template <typename Fn> inline void parallelFill(size_t size, const Fn &fn) {
+    NativeCpuRuntimeObj::getInstance()->parallelFor(size, 1 << 16, fn);
+}
+
 class DataGenerator {
   private:
     virtual void fill(uint32_t *data, size_t size) { IT_TODO_HALT(); }
@@ -27,9 +35,13 @@ class IncrementalGenerator : public DataGenerator {
 
   private:
     template <typename T> void fill(T *data, size_t size) {
-        for (size_t i = 0; i < size; i++) {
-            data[i] = i;
-        }
+        // each worker writes its own contiguous slice; the loop carries no
+        // dependencies, so it vectorizes
+        parallelFill(size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                data[i] = i;
+            }
+        });
     }
 
     void fill(uint32_t *data, size_t size) override {
@@ -44,9 +56,16 @@ template <int val> class ValGenerator : public DataGenerator {
 
   private:
     template <typename T> void fill(T *data, size_t size) {
-        for (size_t i = 0; i < size; i++) {
-            data[i] = val;
-        }
+        parallelFill(size, [&](size_t begin, size_t end) {
+            if (val == 0) {
+                // all-zero bit patterns for both uint32 and float
+                memset(data + begin, 0, (end - begin) * sizeof(T));
+                return;
+            }
+            for (size_t i = begin; i < end; i++) {
+                data[i] = val;
+            }
+        });
     }
 
     void fill(uint32_t *data, size_t size) override {
@@ -56,4 +75,44 @@ template <int val> class ValGenerator : public DataGenerator {
 };
 typedef ValGenerator<1> OneGenerator;
 typedef ValGenerator<0> ZeroGenerator;
+
+/**
+ * @brief Counter-based pseudo-random fill: element i's value is a hash of
+ * (seed, i), so the output is deterministic regardless of how the fill is
+ * chunked across threads — reproducible benchmark inputs at memory-fill
+ * speed. Floats land in [0, 1).
+ */
+class RandomGenerator : public DataGenerator {
+    uint64_t seed;
+
+  public:
+    explicit RandomGenerator(uint64_t seed = 0) : seed(seed) {}
+    virtual ~RandomGenerator() {}
+
+  private:
+    // splitmix64 finalizer over the element counter
+    static uint32_t hash(uint64_t seed, uint64_t i) {
+        uint64_t z = seed + (i + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return (uint32_t)(z ^ (z >> 31));
+    }
+
+    void fill(uint32_t *data, size_t size) override {
+        parallelFill(size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                data[i] = hash(seed, i);
+            }
+        });
+    }
+    void fill(float *data, size_t size) override {
+        parallelFill(size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                // the top 24 bits fit a float mantissa exactly, so the
+                // result stays strictly below 1.0
+                data[i] = (hash(seed, i) >> 8) * (1.0f / 16777216.0f);
+            }
+        });
+    }
+};
 } // namespace infini
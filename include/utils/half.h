@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace infini {
+
+// Bit-level conversions between float32 and the two 16-bit float storage
+// formats. Kernels keep half-precision tensors in memory but convert at
+// the loads and stores and do all arithmetic in fp32; these helpers (and
+// the fp16_t/bf16_t wrappers below) are that boundary. Conversions round
+// to nearest-even; the fp16 path uses F16C instructions when the build
+// enables them.
+
+inline float halfBitsToFloat(uint16_t h) {
+#if defined(__F16C__)
+    return _cvtsh_ss(h);
+#else
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+    uint32_t bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign; // +-0
+        } else {
+            // subnormal: renormalize
+            int shift = 0;
+            while (!(mant & 0x400)) {
+                mant <<= 1;
+                ++shift;
+            }
+            mant &= 0x3FF;
+            bits = sign | ((uint32_t)(113 - shift) << 23) | (mant << 13);
+        }
+    } else if (exp == 0x1F) {
+        bits = sign | 0x7F800000 | (mant << 13); // inf/nan
+    } else {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+#endif
+}
+
+inline uint16_t floatToHalfBits(float f) {
+#if defined(__F16C__)
+    return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t mant = bits & 0x7FFFFF;
+    int32_t exp = (int32_t)((bits >> 23) & 0xFF);
+    if (exp == 0xFF) { // inf/nan
+        return sign | 0x7C00 | (mant ? 0x200 : 0);
+    }
+    exp = exp - 127 + 15;
+    if (exp >= 0x1F) {
+        return sign | 0x7C00; // overflow to inf
+    }
+    if (exp <= 0) {
+        if (exp < -10) {
+            return sign; // underflow to zero
+        }
+        // subnormal result: shift the implicit bit in, round to
+        // nearest-even
+        mant |= 0x800000;
+        uint32_t shift = (uint32_t)(14 - exp);
+        uint16_t half = (uint16_t)(mant >> shift);
+        uint32_t rest = mant & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1))) {
+            ++half;
+        }
+        return sign | half;
+    }
+    uint16_t half = (uint16_t)((exp << 10) | (mant >> 13));
+    uint32_t rest = mant & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+        ++half; // carries into the exponent correctly
+    }
+    return sign | half;
+#endif
+}
+
+inline float bf16BitsToFloat(uint16_t b) {
+    uint32_t bits = (uint32_t)b << 16;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline uint16_t floatToBf16Bits(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+        return (uint16_t)((bits >> 16) | 0x40); // quiet the nan
+    }
+    uint32_t lsb = (bits >> 16) & 1;
+    bits += 0x7FFF + lsb; // round to nearest-even
+    return (uint16_t)(bits >> 16);
+}
+
+// Storage wrappers with the same 2-byte layout as the raw bits, so a
+// Float16/BFloat16 tensor's buffer can be used as an fp16_t*/bf16_t*
+// directly. Arithmetic goes through the float conversions, which is what
+// makes the generic kernel templates compute in fp32 and store half.
+struct fp16_t {
+    uint16_t bits;
+    fp16_t() = default;
+    fp16_t(float f) : bits(floatToHalfBits(f)) {}
+    operator float() const { return halfBitsToFloat(bits); }
+    fp16_t &operator+=(float f) {
+        *this = fp16_t((float)*this + f);
+        return *this;
+    }
+    friend bool operator<(fp16_t a, fp16_t b) {
+        return (float)a < (float)b;
+    }
+};
+static_assert(sizeof(fp16_t) == sizeof(uint16_t), "fp16_t must be 2 bytes");
+
+struct bf16_t {
+    uint16_t bits;
+    bf16_t() = default;
+    bf16_t(float f) : bits(floatToBf16Bits(f)) {}
+    operator float() const { return bf16BitsToFloat(bits); }
+    bf16_t &operator+=(float f) {
+        *this = bf16_t((float)*this + f);
+        return *this;
+    }
+    friend bool operator<(bf16_t a, bf16_t b) {
+        return (float)a < (float)b;
+    }
+};
+static_assert(sizeof(bf16_t) == sizeof(uint16_t), "bf16_t must be 2 bytes");
+
+} // namespace infini
+
+namespace std {
+// the type limits the Clip/FusedElemAct kernels resolve absent bounds to
+template <> class numeric_limits<infini::fp16_t> {
+  public:
+    static infini::fp16_t max() { return infini::fp16_t(65504.0f); }
+    static infini::fp16_t lowest() { return infini::fp16_t(-65504.0f); }
+};
+template <> class numeric_limits<infini::bf16_t> {
+  public:
+    static infini::bf16_t max() {
+        return infini::bf16_t(numeric_limits<float>::max());
+    }
+    static infini::bf16_t lowest() {
+        return infini::bf16_t(numeric_limits<float>::lowest());
+    }
+};
+} // namespace std
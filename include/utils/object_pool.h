@@ -0,0 +1,86 @@
+#pragma once
+#include "core/common.h"
+#include "core/ref.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace infini
+{
+    /**
+     * @brief Chunked bump allocator backing the tensors and operators of
+     * one graph. allocate() hands out slices of 64KB chunks, deallocation
+     * is a no-op, and every chunk is released together when the pool dies.
+     * The pool is held through Ref: each PoolAllocator (including the
+     * copies std::allocate_shared stores in its control blocks) keeps it
+     * alive, so an object that outlives its graph stays valid. Not
+     * thread-safe; graphs are built from one thread.
+     */
+    class ObjectPoolObj
+    {
+        static constexpr size_t chunkBytes = 64 << 10;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char *current = nullptr;
+        size_t offset = 0;
+
+      public:
+        void *allocate(size_t bytes, size_t align)
+        {
+            IT_ASSERT(align <= alignof(std::max_align_t));
+            if (bytes > chunkBytes)
+            {
+                // oversized request gets a dedicated chunk; the current
+                // bump chunk stays usable
+                chunks.emplace_back(new char[bytes]);
+                return chunks.back().get();
+            }
+            offset = (offset + align - 1) & ~(align - 1);
+            if (current == nullptr || offset + bytes > chunkBytes)
+            {
+                chunks.emplace_back(new char[chunkBytes]);
+                current = chunks.back().get();
+                offset = 0;
+            }
+            void *ptr = current + offset;
+            offset += bytes;
+            return ptr;
+        }
+
+        size_t numChunks() const { return chunks.size(); }
+    };
+    using ObjectPool = Ref<ObjectPoolObj>;
+
+    /**
+     * @brief Minimal std allocator over an ObjectPool, for
+     * std::allocate_shared of graph objects.
+     */
+    template <typename T> class PoolAllocator
+    {
+        ObjectPool pool;
+        template <typename U> friend class PoolAllocator;
+
+      public:
+        using value_type = T;
+        explicit PoolAllocator(ObjectPool pool) : pool(std::move(pool)) {}
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &other) : pool(other.pool)
+        {
+        }
+
+        T *allocate(size_t n)
+        {
+            return static_cast<T *>(pool->allocate(n * sizeof(T), alignof(T)));
+        }
+        // individual objects are never returned; the pool frees wholesale
+        void deallocate(T *, size_t) {}
+
+        template <typename U> bool operator==(const PoolAllocator<U> &o) const
+        {
+            return pool == o.pool;
+        }
+        template <typename U> bool operator!=(const PoolAllocator<U> &o) const
+        {
+            return pool != o.pool;
+        }
+    };
+} // namespace infini
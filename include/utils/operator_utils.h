@@ -21,6 +21,80 @@ size_t delocate_index(const Shape &shapeIndex, const Shape &shape,
 // Convert KernelAttrs to a string representation
 std::string get_kernel_attrs_str(const KernelAttrs &kernelAttrs);
 
+/**
+ * @brief Iteration engine for elementwise-style kernels over a (possibly
+ * broadcast) pair of inputs. Shapes are right-aligned against the output
+ * shape, broadcast dims get stride 0, and adjacent dims whose strides are
+ * compatible across all operands are coalesced, so a fully contiguous
+ * [2,3,4,5] walk collapses to one 120-element run. The iteration space is
+ * the output split into numRuns() runs of innerExtent() elements each; runs
+ * are independent, so the outer loop can be split across worker threads.
+ * Within a run each input either advances with stride 1 or stays fixed
+ * (stride 0), which is what the vectorized inner loops key on.
+ */
+class BroadcastIterator {
+  public:
+    BroadcastIterator(const Shape &shapeA, const Shape &shapeB,
+                      const Shape &shapeC);
+    /**
+     * @brief Same iteration space, but with explicit element strides for
+     * the inputs (TensorObj::getStrides), so non-contiguous views walk
+     * their storage correctly. With strided inputs the inner stride can be
+     * any value, not just 0 or 1; kernels fall back to a gather loop then.
+     */
+    BroadcastIterator(const Shape &shapeA, const Shape &stridesA,
+                      const Shape &shapeB, const Shape &stridesB,
+                      const Shape &shapeC);
+
+    // elements in the output
+    size_t size() const { return total; }
+    // innermost coalesced extent, i.e. elements per run
+    size_t innerExtent() const { return dims.back(); }
+    size_t numRuns() const { return total / innerExtent(); }
+    // 0 or 1 after coalescing
+    int innerStrideA() const { return strideA.back(); }
+    int innerStrideB() const { return strideB.back(); }
+    // true when the whole output is one run with both inputs advancing
+    bool isContiguous() const {
+        return numRuns() == 1 && innerStrideA() == 1 && innerStrideB() == 1;
+    }
+
+    // Input offsets of the first element of the given run; the output
+    // offset is run * innerExtent().
+    void locate(size_t run, size_t &offA, size_t &offB) const;
+
+  private:
+    Shape dims;            // coalesced output dims, outermost first
+    Shape strideA, strideB; // matching strides, broadcast dims are 0
+    size_t total = 1;
+};
+
+/**
+ * @brief Single-operand companion to BroadcastIterator for the streaming
+ * unary kernels: decomposes one (possibly strided view) input into
+ * coalesced runs over a dense output of the same shape. A dense input
+ * collapses to one run with stride 1.
+ */
+class RunIterator {
+  public:
+    RunIterator(const Shape &shape, const Shape &strides)
+        : it(shape, strides, shape, strides, shape) {}
+
+    size_t innerExtent() const { return it.innerExtent(); }
+    size_t numRuns() const { return it.numRuns(); }
+    int innerStride() const { return it.innerStrideA(); }
+    // input offset of the first element of the given run; the output
+    // offset is run * innerExtent()
+    size_t locate(size_t run) const {
+        size_t offA, offB;
+        it.locate(run, offA, offB);
+        return offA;
+    }
+
+  private:
+    BroadcastIterator it;
+};
+
 } // namespace infini
 
 #endif
@@ -0,0 +1,255 @@
+#pragma once
+#include "core/common.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace infini
+{
+    /**
+     * @brief Vector with inline storage for up to N elements, used for
+     * Shape: ranks are <= 8 in practice, so shape copies on the hot paths
+     * (inferShape, kernels, graph passes) never touch the heap. Interface
+     * is the std::vector subset the code base uses; spilling past N falls
+     * back to a heap buffer transparently.
+     */
+    template <typename T, size_t N> class SmallVector
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "SmallVector only handles trivially copyable elements");
+
+        T inline_[N];
+        T *data_ = inline_;
+        size_t size_ = 0;
+        size_t capacity_ = N;
+
+        void release()
+        {
+            if (data_ != inline_)
+            {
+                delete[] data_;
+            }
+        }
+
+        void moveFrom(SmallVector &&other) noexcept
+        {
+            if (other.data_ == other.inline_)
+            {
+                std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+                data_ = inline_;
+                capacity_ = N;
+            }
+            else
+            {
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_;
+                other.capacity_ = N;
+            }
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+
+      public:
+        using value_type = T;
+        using size_type = size_t;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        SmallVector() = default;
+        explicit SmallVector(size_t n, const T &value = T())
+        {
+            resize(n, value);
+        }
+        SmallVector(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+        }
+        // implicit interop with std::vector in both directions: attribute
+        // APIs (e.g. permutations) are still std::vector<int>, and call
+        // sites mix them freely with Shape
+        SmallVector(const std::vector<T> &v) { assign(v.begin(), v.end()); }
+        operator std::vector<T>() const
+        {
+            return std::vector<T>(begin(), end());
+        }
+        template <typename It,
+                  typename = std::enable_if_t<!std::is_integral_v<It>>>
+        SmallVector(It first, It last)
+        {
+            assign(first, last);
+        }
+        SmallVector(const SmallVector &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        SmallVector(SmallVector &&other) noexcept
+        {
+            moveFrom(std::move(other));
+        }
+        SmallVector &operator=(const SmallVector &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+        SmallVector &operator=(SmallVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                moveFrom(std::move(other));
+            }
+            return *this;
+        }
+        ~SmallVector() { release(); }
+
+        void reserve(size_t cap)
+        {
+            if (cap <= capacity_)
+            {
+                return;
+            }
+            size_t newCap = std::max(cap, capacity_ * 2);
+            T *buffer = new T[newCap];
+            std::memcpy(buffer, data_, size_ * sizeof(T));
+            release();
+            data_ = buffer;
+            capacity_ = newCap;
+        }
+
+        template <typename It> void assign(It first, It last)
+        {
+            clear();
+            for (; first != last; ++first)
+            {
+                push_back(*first);
+            }
+        }
+
+        void resize(size_t n, const T &value = T())
+        {
+            reserve(n);
+            while (size_ < n)
+            {
+                data_[size_++] = value;
+            }
+            size_ = n;
+        }
+
+        void push_back(const T &value)
+        {
+            reserve(size_ + 1);
+            data_[size_++] = value;
+        }
+        template <typename... Args> T &emplace_back(Args &&...args)
+        {
+            push_back(T(std::forward<Args>(args)...));
+            return back();
+        }
+        void pop_back()
+        {
+            IT_ASSERT(size_ > 0);
+            --size_;
+        }
+        void clear() { size_ = 0; }
+
+        iterator insert(const_iterator pos, const T &value)
+        {
+            return insert(pos, &value, &value + 1);
+        }
+        template <typename It>
+        iterator insert(const_iterator pos, It first, It last)
+        {
+            size_t index = pos - begin();
+            size_t count = std::distance(first, last);
+            reserve(size_ + count);
+            std::memmove(data_ + index + count, data_ + index,
+                         (size_ - index) * sizeof(T));
+            std::copy(first, last, data_ + index);
+            size_ += count;
+            return begin() + index;
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_t index = first - begin();
+            size_t count = last - first;
+            std::memmove(data_ + index, data_ + index + count,
+                         (size_ - index - count) * sizeof(T));
+            size_ -= count;
+            return begin() + index;
+        }
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+        T *data() { return data_; }
+        const T *data() const { return data_; }
+
+        T &operator[](size_t i) { return data_[i]; }
+        const T &operator[](size_t i) const { return data_[i]; }
+        T &at(size_t i)
+        {
+            IT_ASSERT(i < size_);
+            return data_[i];
+        }
+        const T &at(size_t i) const
+        {
+            IT_ASSERT(i < size_);
+            return data_[i];
+        }
+        T &front() { return data_[0]; }
+        const T &front() const { return data_[0]; }
+        T &back() { return data_[size_ - 1]; }
+        const T &back() const { return data_[size_ - 1]; }
+
+        iterator begin() { return data_; }
+        iterator end() { return data_ + size_; }
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+        const_iterator cbegin() const { return data_; }
+        const_iterator cend() const { return data_ + size_; }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator(end());
+        }
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator(begin());
+        }
+    };
+
+    template <typename T, size_t N>
+    bool operator==(const SmallVector<T, N> &a, const SmallVector<T, N> &b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    template <typename T, size_t N>
+    bool operator!=(const SmallVector<T, N> &a, const SmallVector<T, N> &b)
+    {
+        return !(a == b);
+    }
+    template <typename T, size_t N>
+    bool operator<(const SmallVector<T, N> &a, const SmallVector<T, N> &b)
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                            b.end());
+    }
+
+    template <typename T, size_t N>
+    std::string vecToString(const SmallVector<T, N> &vec)
+    {
+        return vecToString(vec.data(), vec.size());
+    }
+} // namespace infini
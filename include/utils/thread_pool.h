@@ -0,0 +1,66 @@
+#pragma once
+#include "core/common.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace infini {
+
+/**
+ * @brief A persistent fork-join worker pool for intra-op parallelism.
+ * Workers are started once and reused across kernel launches, so a
+ * parallelFor costs two lock handoffs instead of thread creation. The
+ * thread count defaults to the INFINI_NUM_THREADS environment variable
+ * (falling back to the hardware concurrency) and can be changed at any
+ * point between launches, so co-located services can be pinned to a
+ * core budget.
+ */
+class ThreadPool {
+  public:
+    explicit ThreadPool(int numThreads = 0); // 0 picks the default
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Split [0, n) into chunks of at least grainSize iterations and
+     * run fn(begin, end) on the workers (the calling thread participates).
+     * Returns when every chunk is done. Ranges too small to fill one chunk
+     * per worker, and nested calls from inside a task, run inline.
+     *
+     * Safe to call from several threads: concurrent launches on the same
+     * pool are serialized (graphs that should overlap belong on their own
+     * runtime, and thus their own pool). setNumThreads, by contrast, must
+     * not race with launches.
+     */
+    void parallelFor(size_t n, size_t grainSize,
+                     const std::function<void(size_t, size_t)> &fn);
+
+    void setNumThreads(int numThreads);
+    int numThreads() const { return nThreads; }
+
+  private:
+    struct Task {
+        size_t begin, end;
+    };
+    void workerLoop();
+    void runTasks(std::unique_lock<std::mutex> &lk);
+    void start(int numThreads);
+    void stop();
+    static int defaultNumThreads();
+
+    int nThreads;
+    vector<std::thread> workers;
+    // held by an external caller for its whole launch, so two threads
+    // sharing one pool cannot interleave their task lists
+    std::mutex submitMtx;
+    std::mutex mtx;
+    std::condition_variable cvTask, cvDone;
+    const std::function<void(size_t, size_t)> *job = nullptr;
+    vector<Task> tasks;
+    size_t nextTask = 0, pendingTasks = 0;
+    uint64_t generation = 0;
+    bool shutdown = false;
+};
+
+} // namespace infini
@@ -1,83 +1,152 @@
 #include "core/allocator.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
 #include <utility>
 #include <map>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 namespace infini
 {
-    Allocator::Allocator(Runtime runtime) : runtime(runtime)
+    Allocator::Allocator(Runtime runtime, size_t alignment,
+                         size_t pageAlignThreshold)
+        : runtime(runtime), alignment(alignment),
+          pageAlignThreshold(pageAlignThreshold)
     {
+        IT_ASSERT(alignment >= sizeof(uint64_t) &&
+                      (alignment & (alignment - 1)) == 0,
+                  "alignment must be a power of two covering every DataType");
         used = 0;
         peak = 0;
+        maxAlignment = alignment;
         ptr = nullptr;
+        rawPtr = nullptr;
+        capacity = 0;
+        hugePages = false;
+        mmapped = false;
+        hugeBytes = 0;
+        tracing = false;
+        traceFuid = 0;
+        traceOpIndex = -1;
+    }
+
+    Allocator::Allocator(Allocator &&other) noexcept
+        : runtime(std::move(other.runtime)), used(other.used),
+          peak(other.peak), alignment(other.alignment),
+          pageAlignThreshold(other.pageAlignThreshold),
+          maxAlignment(other.maxAlignment), ptr(other.ptr),
+          rawPtr(other.rawPtr), capacity(other.capacity),
+          hugePages(other.hugePages), mmapped(other.mmapped),
+          hugeBytes(other.hugeBytes),
+          freeBlocks(std::move(other.freeBlocks)),
+          freeBySize(std::move(other.freeBySize)), tracing(other.tracing),
+          traceFuid(other.traceFuid), traceOpIndex(other.traceOpIndex),
+          trace(std::move(other.trace))
+    {
+        other.ptr = nullptr;
+        other.rawPtr = nullptr;
+        other.capacity = 0;
+        other.mmapped = false;
+        other.hugeBytes = 0;
+    }
 
-        // 'alignment' defaults to sizeof(uint64_t), because it is the length of
-        // the longest data type currently supported by the DataType field of
-        // the tensor
-        alignment = sizeof(uint64_t);
+    void Allocator::reset()
+    {
+        freeBlocks.clear();
+        freeBySize.clear();
+        used = 0;
+        peak = 0;
+        maxAlignment = alignment;
+        // keep rawPtr/capacity: the buffer stays warm for the next plan
+        ptr = nullptr;
+        trace.clear();
+        traceFuid = 0;
+        traceOpIndex = -1;
     }
 
     Allocator::~Allocator()
     {
-        if (this->ptr != nullptr)
+        if (this->rawPtr != nullptr)
         {
-            runtime->dealloc(this->ptr);
+            releaseBackingBuffer();
         }
     }
 
-    size_t Allocator::alloc(size_t size) {
+    size_t Allocator::alloc(size_t size, size_t align) {
         IT_ASSERT(this->ptr == nullptr);
+        if (align == 0) {
+            align = alignment;
+        }
+        IT_ASSERT((align & (align - 1)) == 0,
+                  "alignment must be a power of two");
+        align = std::max(align, alignment);
+        // 大块对齐到页边界，方便后续的THP/NUMA优化
+        if (pageAlignThreshold > 0 && size >= pageAlignThreshold) {
+            align = std::max(align, pageSize);
+        }
+        maxAlignment = std::max(maxAlignment, align);
         size = getAlignedSize(size);
 
+        // Best fit: the smallest free block that is large enough, found in
+        // O(log n) through the size-ordered index. Best fit keeps large
+        // blocks intact, which matters under the alloc/free churn the
+        // lifetime-aware planner generates. Blocks whose start needs
+        // padding for `align` must also fit that padding; the padding is
+        // given back as a free block.
+        for (auto it = freeBySize.lower_bound(size); it != freeBySize.end();
+             ++it) {
+            size_t addr = it->second;
+            size_t blockSize = it->first;
+            size_t alignedAddr = roundUp(addr, align);
+            size_t padding = alignedAddr - addr;
+            if (blockSize < padding + size) {
+                continue;
+            }
+            eraseFreeBlock(addr, blockSize);
+            if (padding > 0) {
+                insertFreeBlock(addr, padding);
+            }
+            // If block is larger than needed, split it
+            if (blockSize > padding + size) {
+                insertFreeBlock(alignedAddr + size, blockSize - padding - size);
+            }
+            used += size;
+            recordEvent(true, alignedAddr, size);
+            return alignedAddr;
+        }
+
+        // No block fits. If the block bordering the current peak is free
+        // and holds an aligned start, extend it so peak only grows by the
+        // shortfall.
         if (!freeBlocks.empty()) {
-            auto lastBlock = freeBlocks.rbegin(); // Get the last block
+            auto lastBlock = std::prev(freeBlocks.end());
             if (lastBlock->first + lastBlock->second == peak) {
-                // This is an end block, check if we can use/extend it
-                if (lastBlock->second >= size) {
-                    // Use the end block
-                    size_t addr = lastBlock->first;
-                    size_t blockSize = lastBlock->second;
-                    freeBlocks.erase(std::prev(freeBlocks.end()));
-                    
-                    if (blockSize > size) {
-                        freeBlocks[addr + size] = blockSize - size;
+                size_t blockAddr = lastBlock->first;
+                size_t blockSize = lastBlock->second;
+                size_t alignedAddr = roundUp(blockAddr, align);
+                if (alignedAddr < peak) {
+                    eraseFreeBlock(blockAddr, blockSize);
+                    if (alignedAddr > blockAddr) {
+                        insertFreeBlock(blockAddr, alignedAddr - blockAddr);
                     }
-                    
-                    used += size;
-                    return addr;
-                } else {
-                    // Extend the end block
-                    size_t addr = lastBlock->first;
-                    size_t additionalSize = size - lastBlock->second;
-                    freeBlocks.erase(std::prev(freeBlocks.end()));
-                    peak += additionalSize;
+                    peak = alignedAddr + size;
                     used += size;
-                    return addr;
+                    recordEvent(true, alignedAddr, size);
+                    return alignedAddr;
                 }
             }
         }
-        
-        for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
-            if (it->second >= size) {
-                size_t addr = it->first;
-                size_t blockSize = it->second;
-                
-                // Remove the free block
-                freeBlocks.erase(it);
-                
-                // If block is larger than needed, split it
-                if (blockSize > size) {
-                    freeBlocks[addr + size] = blockSize - size;
-                }
-                
-                used += size;
-                return addr;
-            }
-        }
 
-        size_t addr = peak;
-        peak += size;
+        size_t alignedAddr = roundUp(peak, align);
+        if (alignedAddr > peak) {
+            insertFreeBlock(peak, alignedAddr - peak);
+        }
+        peak = alignedAddr + size;
         used += size;
-        return addr;
+        recordEvent(true, alignedAddr, size);
+        return alignedAddr;
     }
 
     void Allocator::free(size_t addr, size_t size)
@@ -86,27 +155,238 @@ namespace infini
         size = getAlignedSize(size);
 
         used -= size;
-        
-        // Insert the freed block
-        freeBlocks[addr] = size;
-        
-        // Merge with adjacent blocks
-        auto it = freeBlocks.find(addr);
-        
+        recordEvent(false, addr, size);
+
         // Merge with next block
-        auto next = std::next(it);
+        auto next = freeBlocks.lower_bound(addr);
         if (next != freeBlocks.end() && addr + size == next->first) {
             size += next->second;
-            freeBlocks.erase(next);
-            it->second = size;
+            eraseFreeBlock(next->first, next->second);
         }
-        
+
         // Merge with previous block
-        if (it != freeBlocks.begin()) {
-            auto prev = std::prev(it);
+        next = freeBlocks.lower_bound(addr);
+        if (next != freeBlocks.begin()) {
+            auto prev = std::prev(next);
             if (prev->first + prev->second == addr) {
-                prev->second += size;
-                freeBlocks.erase(it);
+                size += prev->second;
+                addr = prev->first;
+                eraseFreeBlock(prev->first, prev->second);
+            }
+        }
+
+        // Insert the (merged) freed block into both indexes
+        insertFreeBlock(addr, size);
+    }
+
+    void Allocator::recordEvent(bool isAlloc, size_t addr, size_t size)
+    {
+        if (!tracing)
+        {
+            return;
+        }
+        trace.push_back(
+            TraceEvent{isAlloc, addr, size, traceFuid, traceOpIndex, used});
+    }
+
+    void Allocator::setTracing(bool enable)
+    {
+        tracing = enable;
+        if (enable)
+        {
+            trace.clear();
+        }
+    }
+
+    std::string Allocator::traceToChromeJson() const
+    {
+        // one lane ("tid") per arena offset: a block's lifetime shows as a
+        // span in its lane, and the counter track plots used bytes over
+        // event time
+        std::stringstream out;
+        out << "{\"traceEvents\":[";
+        for (size_t i = 0; i < trace.size(); ++i)
+        {
+            const auto &e = trace[i];
+            if (i > 0)
+            {
+                out << ",";
+            }
+            out << "\n{\"name\":\"fuid " << e.fuid << "\",\"cat\":\"arena\","
+                << "\"ph\":\"" << (e.isAlloc ? "B" : "E") << "\",\"ts\":" << i
+                << ",\"pid\":0,\"tid\":" << e.addr
+                << ",\"args\":{\"bytes\":" << e.size
+                << ",\"op_index\":" << e.opIndex << "}},"
+                << "\n{\"name\":\"used bytes\",\"ph\":\"C\",\"ts\":" << i
+                << ",\"pid\":0,\"args\":{\"used\":" << e.usedAfter << "}}";
+        }
+        out << "\n]}\n";
+        return out.str();
+    }
+
+    std::string Allocator::peakContributionTable() const
+    {
+        // replay the trace and snapshot the live set at the high-water mark
+        std::map<size_t, TraceEvent> live, atPeak;
+        size_t peakUsed = 0;
+        for (const auto &e : trace)
+        {
+            if (e.isAlloc)
+            {
+                live[e.addr] = e;
+            }
+            else
+            {
+                live.erase(e.addr);
+            }
+            if (e.usedAfter > peakUsed)
+            {
+                peakUsed = e.usedAfter;
+                atPeak = live;
+            }
+        }
+
+        std::vector<TraceEvent> rows;
+        rows.reserve(atPeak.size());
+        for (const auto &[addr, e] : atPeak)
+        {
+            rows.push_back(e);
+        }
+        std::sort(rows.begin(), rows.end(),
+                  [](const TraceEvent &a, const TraceEvent &b)
+                  { return a.size > b.size; });
+
+        std::stringstream out;
+        out << "peak " << peakUsed << " bytes across " << rows.size()
+            << " tensors\n";
+        out << "fuid\top_index\toffset\tbytes\n";
+        for (const auto &e : rows)
+        {
+            out << e.fuid << "\t" << e.opIndex << "\t" << e.addr << "\t"
+                << e.size << "\n";
+        }
+        return out.str();
+    }
+
+    void Allocator::saveTrace(const std::string &path) const
+    {
+        std::ofstream out(path);
+        IT_ASSERT(out.good(), "cannot open " + path + " for writing");
+        out << "ITAT 1\n";
+        // frees are written as the ordinal of the alloc they release:
+        // addresses are a property of this run's policy, ordinals are a
+        // property of the workload
+        std::map<size_t, size_t> addrToOrdinal;
+        size_t ordinal = 0;
+        for (const auto &e : trace)
+        {
+            if (e.isAlloc)
+            {
+                addrToOrdinal[e.addr] = ordinal++;
+                out << "a " << e.size << " " << e.fuid << " " << e.opIndex
+                    << "\n";
+            }
+            else
+            {
+                auto it = addrToOrdinal.find(e.addr);
+                IT_ASSERT(it != addrToOrdinal.end(),
+                          "trace frees a block it never allocated");
+                out << "f " << it->second << "\n";
+                addrToOrdinal.erase(it);
+            }
+        }
+        IT_ASSERT(out.good(), "failed writing " + path);
+    }
+
+    Allocator::ReplayStats Allocator::replayTrace(const std::string &path)
+    {
+        std::ifstream in(path);
+        IT_ASSERT(in.good(), "cannot open " + path);
+        std::string magic;
+        int version = 0;
+        in >> magic >> version;
+        IT_ASSERT(magic == "ITAT" && version == 1,
+                  path + " is not an allocation trace");
+
+        // parse up front so planMs measures alloc/free work only
+        struct Event
+        {
+            bool isAlloc;
+            size_t size;    // alloc only
+            size_t ordinal; // free only
+        };
+        std::vector<Event> events;
+        std::string kind;
+        while (in >> kind)
+        {
+            if (kind == "a")
+            {
+                size_t size;
+                UidBaseType fuid;
+                int opIndex;
+                in >> size >> fuid >> opIndex;
+                events.push_back({true, size, 0});
+            }
+            else if (kind == "f")
+            {
+                size_t ordinal;
+                in >> ordinal;
+                events.push_back({false, 0, ordinal});
+            }
+            else
+            {
+                IT_ASSERT(false, "bad event kind in " + path);
+            }
+        }
+
+        reset();
+        std::vector<std::pair<size_t, size_t>> blocks; // ordinal -> addr,size
+        blocks.reserve(events.size());
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (const auto &e : events)
+        {
+            if (e.isAlloc)
+            {
+                blocks.emplace_back(alloc(e.size), e.size);
+            }
+            else
+            {
+                IT_ASSERT(e.ordinal < blocks.size(),
+                          "trace frees a block before its alloc");
+                free(blocks[e.ordinal].first, blocks[e.ordinal].second);
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        ReplayStats stats;
+        stats.events = events.size();
+        stats.peakBytes = peak;
+        stats.planMs =
+            std::chrono::duration<double, std::milli>(end - begin).count();
+        stats.freeBytes = 0;
+        stats.largestFreeBlock = 0;
+        for (const auto &[size, addr] : freeBySize)
+        {
+            stats.freeBytes += size;
+            stats.largestFreeBlock = std::max(stats.largestFreeBlock, size);
+        }
+        return stats;
+    }
+
+    void Allocator::insertFreeBlock(size_t addr, size_t size)
+    {
+        freeBlocks.emplace(addr, size);
+        freeBySize.emplace(size, addr);
+    }
+
+    void Allocator::eraseFreeBlock(size_t addr, size_t size)
+    {
+        freeBlocks.erase(addr);
+        auto range = freeBySize.equal_range(size);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == addr) {
+                freeBySize.erase(it);
+                break;
             }
         }
     }
@@ -115,12 +395,109 @@ namespace infini
     {
         if (this->ptr == nullptr)
         {
-            this->ptr = runtime->alloc(this->peak);
-            printf("Allocator really alloc: %p %lu bytes\n", this->ptr, peak);
+            // over-allocate so the base itself can honor the largest
+            // alignment handed out; offsets are aligned relative to base
+            size_t needed = this->peak + this->maxAlignment;
+            if (this->rawPtr != nullptr && this->capacity < needed)
+            {
+                // grow-only: the recycled arena is too small for this plan
+                releaseBackingBuffer();
+            }
+            if (this->rawPtr == nullptr)
+            {
+                allocBackingBuffer(needed);
+                printf("Allocator really alloc: %p %lu bytes\n", this->rawPtr,
+                       peak);
+            }
+            this->ptr = reinterpret_cast<void *>(
+                roundUp(reinterpret_cast<size_t>(this->rawPtr),
+                        this->maxAlignment));
         }
         return this->ptr;
     }
 
+    double Allocator::warmup()
+    {
+        auto start = std::chrono::steady_clock::now();
+        char *base = static_cast<char *>(getPtr());
+        // read-modify-write one byte per page: commits the page without
+        // clobbering bytes that already hold data
+        auto cpuRuntime = static_cast<NativeCpuRuntimeObj *>(runtime.get());
+        size_t span = capacity - (base - static_cast<char *>(rawPtr));
+        size_t nPages = (span + pageSize - 1) / pageSize;
+        cpuRuntime->parallelFor(nPages, 16, [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p)
+            {
+                volatile char *byte = base + std::min(p * pageSize, span - 1);
+                *byte = *byte;
+            }
+        });
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    void Allocator::allocBackingBuffer(size_t needed)
+    {
+#ifdef __linux__
+        if (hugePages)
+        {
+            // explicit huge pages first; needs a reserved hugetlb pool and
+            // fails cleanly when there is none
+            size_t len = roundUp(needed, hugePageSize);
+            void *p = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                rawPtr = p;
+                capacity = len;
+                mmapped = true;
+                hugeBytes = len;
+                return;
+            }
+        }
+#endif
+        rawPtr = runtime->alloc(needed);
+        capacity = needed;
+        mmapped = false;
+        hugeBytes = 0;
+#ifdef __linux__
+        if (hugePages && rawPtr != nullptr)
+        {
+            // fall back to transparent huge pages on the page-aligned
+            // interior; the kernel promotes opportunistically, so this
+            // counts advised bytes
+            size_t begin = roundUp(reinterpret_cast<size_t>(rawPtr), pageSize);
+            size_t end =
+                (reinterpret_cast<size_t>(rawPtr) + capacity) & ~(pageSize - 1);
+            if (end > begin &&
+                madvise(reinterpret_cast<void *>(begin), end - begin,
+                        MADV_HUGEPAGE) == 0)
+            {
+                hugeBytes = end - begin;
+            }
+        }
+#endif
+    }
+
+    void Allocator::releaseBackingBuffer()
+    {
+#ifdef __linux__
+        if (mmapped)
+        {
+            munmap(rawPtr, capacity);
+        }
+        else
+#endif
+        {
+            runtime->dealloc(rawPtr);
+        }
+        rawPtr = nullptr;
+        capacity = 0;
+        mmapped = false;
+        hugeBytes = 0;
+    }
+
     size_t Allocator::getAlignedSize(size_t size)
     {
         return ((size - 1) / this->alignment + 1) * this->alignment;
@@ -128,7 +505,20 @@ namespace infini
 
     void Allocator::info()
     {
+        // largest free block vs total free bytes shows how fragmented the
+        // arena is: equal means one contiguous hole, a small ratio means
+        // the free space is shredded
+        size_t totalFree = peak - used;
+        size_t largestFree = freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
         std::cout << "Used memory: " << this->used
-                  << ", peak memory: " << this->peak << std::endl;
+                  << ", peak memory: " << this->peak
+                  << ", fragmentation: largest free block " << largestFree
+                  << " of " << totalFree << " free bytes";
+        if (hugePages)
+        {
+            std::cout << ", huge pages: " << hugeBytes << " of " << capacity
+                      << " arena bytes";
+        }
+        std::cout << std::endl;
     }
 }
@@ -1,9 +1,19 @@
 #include "core/graph.h"
+#include "core/kernel.h"
+#include "core/perf_engine.h"
+#include "core/plan.h"
 #include "operators/transpose.h"
 #include "operators/matmul.h"
+#include "operators/element_wise.h"
+#include "operators/quantize.h"
+#include "operators/unary.h"
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <numeric>
 #include <queue>
+#include <set>
+#include <unordered_map>
 
 namespace infini
 {
@@ -12,6 +22,7 @@ namespace infini
     {
         sorted = false;
         ops.push_back(op);
+        opIndex.emplace(op->getGuid(), op);
         for (auto &input : op->getInputs())
         {
             if (input)
@@ -76,35 +87,57 @@ namespace infini
         {
             return true;
         }
+        // Kahn's algorithm: count the unfinished producers of every op once,
+        // then repeatedly emit ops whose count reached zero. Each edge is
+        // touched exactly once, so this is O(V+E) instead of the former
+        // O(V^2) restart scan.
         std::vector<Operator> sorted;
-        std::unordered_set<OperatorObj *> flags;
+        std::unordered_map<OperatorObj *, size_t> inDegree;
+        std::queue<Operator> ready;
         sorted.reserve(ops.size());
-        flags.reserve(ops.size());
-        while (sorted.size() < ops.size())
-        {
-            // Any node is move to sorted in this loop.
-            auto modified = false;
-            for (auto const &op : ops)
-            {
-                if (auto const &inputs = op->getInputs();
-                    flags.find(op.get()) == flags.end() &&
-                    std::all_of(inputs.begin(), inputs.end(),
-                                [&flags](auto const &input)
-                                {
-                                    auto ptr = input->getSource().get();
-                                    return !ptr || flags.find(ptr) != flags.end();
-                                }))
+        inDegree.reserve(ops.size());
+        for (auto const &op : ops)
+        {
+            size_t degree = 0;
+            for (auto const &input : op->getInputs())
+            {
+                if (input && input->getSource())
                 {
-                    modified = true;
-                    sorted.emplace_back(op);
-                    flags.insert(op.get());
+                    ++degree;
                 }
             }
-            if (!modified)
+            inDegree[op.get()] = degree;
+            if (degree == 0)
             {
-                return false;
+                ready.push(op);
             }
         }
+        while (!ready.empty())
+        {
+            auto op = ready.front();
+            ready.pop();
+            sorted.emplace_back(op);
+            for (auto const &output : op->getOutputs())
+            {
+                if (!output)
+                {
+                    continue;
+                }
+                for (auto const &succ : output->getTargets())
+                {
+                    auto it = inDegree.find(succ.get());
+                    if (it != inDegree.end() && --it->second == 0)
+                    {
+                        ready.push(succ);
+                    }
+                }
+            }
+        }
+        if (sorted.size() < ops.size())
+        {
+            // leftover ops form at least one ring
+            return false;
+        }
         this->ops = std::move(sorted);
         return this->sorted = true;
     }
@@ -118,38 +151,215 @@ namespace infini
         // 1. 去除冗余的算子（例如，两个相邻的算子都是 transpose 算子，且做的是相反的操作，可以将其全部删除）
         // 2. 合并算子（例如，矩阵乘算子中含有属性transA、transB，如果其输入存在transpose，且对最后两个维度做交换，就可以将transpose融入到矩阵乘算子的属性中去）
         // =================================== 作业 ===================================
-    
-        bool optimized = true;
-        while (optimized) {
-            optimized = false;
-            
-            // 规则1: 去除冗余的transpose算子
-            optimized |= removeRedundantTranspose();
-            // 规则2: 将transpose融入matmul算子
-            optimized |= fuseTransposeIntoMatmul();
-            
+
+        // Worklist-driven rewriting: rules are registered per OpType, every
+        // op is seeded once, and a successful rewrite re-enqueues only the
+        // ops around the changed region, so a full optimize() is near-linear
+        // in the graph size instead of restarting a scan after each match.
+        // 规则1: 去除冗余的transpose算子对 (rewriteTransposePair)
+        // 规则2: 将transpose融入matmul算子 (rewriteTransposeIntoMatmul)
+        // 规则3: 合并elementwise+激活算子对 (rewriteElementWiseActivation)
+        // 规则4: 量化matmul改写为int8计算 (rewriteQuantizedMatmul)
+        static const std::unordered_multimap<OpType::underlying_t, RewriteRule>
+            rules = {
+                {OpType::Transpose, &GraphObj::rewriteTransposePair},
+                {OpType::MatMul, &GraphObj::rewriteTransposeIntoMatmul},
+                {OpType::MatMul, &GraphObj::rewriteQuantizedMatmul},
+                {OpType::Add, &GraphObj::rewriteElementWiseActivation},
+                {OpType::Sub, &GraphObj::rewriteElementWiseActivation},
+                {OpType::Mul, &GraphObj::rewriteElementWiseActivation},
+                {OpType::Div, &GraphObj::rewriteElementWiseActivation},
+            };
+
+        std::queue<WRef<OperatorObj>> worklist;
+        for (auto &op : ops) {
+            worklist.emplace(op);
         }
-        
+        while (!worklist.empty()) {
+            auto op = worklist.front().lock();
+            worklist.pop();
+            // Skip ops an earlier rewrite removed. Outside references can
+            // keep a removed op (and its stale tensor links) alive, so check
+            // graph membership rather than liveness.
+            if (!op || !opIndex.count(op->getGuid())) {
+                continue;
+            }
+            OpVec affected;
+            // 常量折叠对所有算子类型生效，先于按OpType注册的规则尝试
+            bool rewritten = rewriteFoldConstant(op, affected);
+            if (!rewritten) {
+                auto range = rules.equal_range(op->getOpType().underlying());
+                for (auto it = range.first; it != range.second; ++it) {
+                    if ((this->*(it->second))(op, affected)) {
+                        rewritten = true;
+                        break;
+                    }
+                }
+            }
+            if (rewritten) {
+                // op is gone after a rewrite; its replacement (if any) and
+                // the neighbors it touched were pushed via `affected`
+                for (auto &a : affected) {
+                    if (a) {
+                        worklist.emplace(a);
+                    }
+                }
+            }
+        }
+
         // 重新标记需要拓扑排序
         sorted = false;
+
+        // 全局清理pass：先CSE合并重复算子，再DCE删除不可达的算子
+        eliminateCommonSubexpr();
+        eliminateDeadCode();
+        sorted = false;
+    }
+
+    bool GraphObj::eliminateCommonSubexpr()
+    {
+        // Visit ops in topological order so producers are deduped before
+        // their consumers; a consumer of two merged producers then sees
+        // identical input fuids and cascades in the same pass.
+        topo_sort();
+        bool changed = false;
+        std::unordered_map<std::string, Operator> seen;
+        for (size_t i = 0; i < ops.size();) {
+            auto op = ops[i];
+            std::ostringstream key;
+            key << op->getOpType().underlying();
+            for (auto &input : op->getInputs()) {
+                key << ',' << (input ? (int)input->getFuid() : -1);
+            }
+            for (auto attr : op->getOpAttrVector()) {
+                key << ';' << attr;
+            }
+            auto [it, inserted] = seen.emplace(key.str(), op);
+            if (inserted) {
+                ++i;
+                continue;
+            }
+
+            // op重复计算了kept的结果，把它的消费者改接到kept的输出上
+            auto kept = it->second;
+            IT_ASSERT(op->getOutputs().size() == kept->getOutputs().size());
+            for (size_t j = 0; j < op->getOutputs().size(); ++j) {
+                auto from = op->getOutput(j), to = kept->getOutput(j);
+                for (auto &target : from->getTargets()) {
+                    target->replaceInput(from, to);
+                    to->addTarget(target);
+                    kept->addSuccessors(target);
+                    target->addPredecessors(kept);
+                }
+            }
+            for (auto &input : op->getInputs()) {
+                input->removeTarget(op);
+            }
+            auto outputs = op->getOutputs();
+            removeOperatorfromGraph(op);
+            for (auto &output : outputs) {
+                removeTensor(output);
+            }
+            changed = true;
+        }
+        sorted = false;
+        return changed;
+    }
+
+    bool GraphObj::eliminateDeadCode()
+    {
+        // ops an output tensor transitively depends on are live
+        std::unordered_set<OperatorObj *> live;
+        std::queue<Operator> pending;
+        for (auto &tensor : tensors) {
+            if (tensor->getTargets().empty()) {
+                if (auto source = tensor->getSource()) {
+                    pending.push(source);
+                }
+            }
+        }
+        while (!pending.empty()) {
+            auto op = pending.front();
+            pending.pop();
+            if (!live.insert(op.get()).second) {
+                continue;
+            }
+            for (auto &input : op->getInputs()) {
+                if (input) {
+                    if (auto source = input->getSource()) {
+                        pending.push(source);
+                    }
+                }
+            }
+        }
+
+        bool changed = false;
+        for (size_t i = ops.size(); i-- > 0;) {
+            auto op = ops[i];
+            if (live.count(op.get())) {
+                continue;
+            }
+            for (auto &input : op->getInputs()) {
+                input->removeTarget(op);
+            }
+            for (auto &output : op->getOutputs()) {
+                output->setSource(nullptr);
+            }
+            removeOperatorfromGraph(op);
+            changed = true;
+        }
+        // tensors no remaining op touches are dead too; constants with bound
+        // data are kept, they cost no allocator memory
+        for (size_t i = tensors.size(); i-- > 0;) {
+            auto &tensor = tensors[i];
+            if (!tensor->getSource() && tensor->getTargets().empty() &&
+                !tensor->hasData()) {
+                removeTensor(tensor);
+                changed = true;
+            }
+        }
+        return changed;
     }
 
     Tensor GraphObj::getTensor(int fuid) const
     {
-        for (auto tensor : tensors)
+        auto it = fuidIndex.find(fuid);
+        return it == fuidIndex.end() ? nullptr : it->second;
+    }
+
+    Operator GraphObj::getOperator(UidBaseType guid) const
+    {
+        auto it = opIndex.find(guid);
+        return it == opIndex.end() ? nullptr : it->second;
+    }
+
+    void GraphObj::setTensorShape(const Tensor &tensor, const Shape &shape)
+    {
+        IT_ASSERT(tensorSet.count(tensor.get()));
+        if (tensor->getDims() == shape)
         {
-            if (tensor->getFuid() == fuid)
-            {
-                return tensor;
-            }
+            return;
+        }
+        tensor->setShape(shape);
+        for (auto &target : tensor->getTargets())
+        {
+            shapeDirty.insert(target.get());
         }
-        return nullptr;
     }
 
     void GraphObj::shape_infer()
     {
+        if (shapeDirty.empty())
+        {
+            return;
+        }
+        IT_ASSERT(topo_sort() == true);
         for (auto &op : ops)
         {
+            if (!shapeDirty.erase(op.get()))
+            {
+                continue;
+            }
             auto ans = op->inferShape();
             IT_ASSERT(ans.has_value());
             auto oldOutputs = op->getOutputs();
@@ -158,54 +368,615 @@ namespace infini
             for (int i = 0; i < (int)ans.value().size(); ++i)
             {
                 auto newShape = ans.value()[i];
-                auto oldShape = oldOutputs[i]->getDims();
-                auto fuid = oldOutputs[i]->getFuid();
-                if (newShape != oldShape)
+                auto output = oldOutputs[i];
+                if (newShape == output->getDims())
+                {
+                    // unchanged: the dirty region ends here
+                    continue;
+                }
+                output->setShape(newShape);
+                for (auto &target : output->getTargets())
+                {
+                    shapeDirty.insert(target.get());
+                }
+            }
+        }
+        // whatever remains marked belongs to ops no longer in the graph
+        shapeDirty.clear();
+    }
+
+    Tensor GraphObj::inplaceInputOf(const Operator &op,
+                                    const Tensor &output) const
+    {
+        static const std::unordered_set<OpType::underlying_t> inplaceTypes{
+            OpType::Relu,  OpType::Clip, OpType::Cast,
+            OpType::Add,   OpType::Sub,  OpType::Mul,
+            OpType::Div,   OpType::FusedElemAct};
+        if (!inplaceTypes.count(op->getOpType().underlying()))
+        {
+            return nullptr;
+        }
+        for (auto &input : op->getInputs())
+        {
+            // 被广播的操作数或改变元素大小的cast不能原地写
+            if (input->getDims() != output->getDims() ||
+                input->getBytes() != output->getBytes())
+            {
+                continue;
+            }
+            // 视图与其storage tensor共享内存，别的读者从这里看不到
+            if (input->isView())
+            {
+                continue;
+            }
+            // The write must happen after every other read of the same
+            // bytes. Walk the input's Reshape/Flatten/Identity alias chain:
+            // with a single reader at each link the chain is totally
+            // ordered, so this op is the last one to touch the storage.
+            // (An ancestor that is itself an in-place output already proved
+            // the same property for the bytes it took over.)
+            auto t = input;
+            bool safe = true;
+            while (true)
+            {
+                if (t->getTargets().size() != 1 || t->hasData())
+                {
+                    safe = false;
+                    break;
+                }
+                auto source = t->getSource();
+                // 图的输入/权重对外可见，保持原值
+                if (!source)
+                {
+                    safe = false;
+                    break;
+                }
+                auto type = source->getOpType();
+                if (type != OpType::Reshape && type != OpType::Flatten &&
+                    type != OpType::Identity)
+                {
+                    break;
+                }
+                t = source->getInputs(0);
+            }
+            if (safe)
+            {
+                return input;
+            }
+        }
+        return nullptr;
+    }
+
+    Tensor GraphObj::aliasRootOf(const Tensor &tensor) const
+    {
+        auto root = tensor;
+        while (true)
+        {
+            // 视图直接借用其storage tensor的内存
+            if (auto storage = root->getViewStorage())
+            {
+                root = storage;
+                continue;
+            }
+            auto source = root->getSource();
+            if (!source)
+            {
+                break;
+            }
+            auto type = source->getOpType();
+            if (type == OpType::Reshape || type == OpType::Flatten ||
+                type == OpType::Identity)
+            {
+                // byte-for-byte aliasing presumes the input is dense
+                if (!source->getInputs(0)->isContiguous())
                 {
-                    auto tensor = this->getTensor(fuid);
-                    tensor->setShape(newShape);
+                    break;
                 }
+                root = source->getInputs(0);
+                continue;
             }
+            // elementwise ops stream index-by-index, so they may overwrite
+            // an input that dies with them
+            if (auto input = inplaceInputOf(source, root))
+            {
+                root = input;
+                continue;
+            }
+            break;
         }
+        return root;
     }
 
-    void GraphObj::dataMalloc()
+    void GraphObj::dataMalloc(bool materialize)
     {
         // topological sorting first
         IT_ASSERT(topo_sort() == true);
 
-        std::vector<size_t> offsets;
+        // Reshape/Flatten/Identity outputs are byte-identical to their
+        // inputs: only alias roots get an allocation, everything else
+        // borrows its root's storage. All the liveness bookkeeping below
+        // is therefore per root, with uses summed over every alias.
+        std::unordered_map<TensorObj *, Tensor> rootOf;
+        std::unordered_map<TensorObj *, int> remainingUses;
+        std::unordered_set<TensorObj *> pinned;
+        rootOf.reserve(tensors.size());
         for (auto &tensor : tensors) {
-            // 获取tensor需要的内存大小
-            size_t tensorSize = tensor->getBytes();
-            
+            auto root = aliasRootOf(tensor);
+            rootOf.emplace(tensor.get(), root);
+            remainingUses[root.get()] += (int)tensor->getTargets().size();
+            // 图的输入/权重和输出常驻，不参与内存复用
+            if (!tensor->getSource() || tensor->getTargets().empty()) {
+                pinned.insert(root.get());
+            }
+        }
+
+        std::unordered_map<TensorObj *, size_t> offsets;
+        // for the allocation trace: which op's walk step drives the event
+        int traceOpIndex = -1;
+        auto allocRoot = [&](const Tensor &root) {
+            // 已绑定数据的常量（例如常量折叠的结果）保留自己的存储
+            if (root->hasData() || offsets.count(root.get())) {
+                return;
+            }
             // 使用allocator分配内存，获取偏移地址
-            size_t offset = allocator.alloc(tensorSize);
-            offsets.push_back(offset);
+            allocator.setTraceContext(root->getFuid(), traceOpIndex);
+            offsets.emplace(root.get(), allocator.alloc(root->getBytes()));
+        };
+
+        // 图的输入和权重在第一个算子执行前就已存在
+        for (auto &tensor : tensors) {
+            if (!tensor->getSource()) {
+                allocRoot(rootOf.at(tensor.get()));
+            }
         }
 
-        // 为每个tensor分配内存
-        for (size_t i = 0; i < tensors.size(); i++) {
-            auto &tensor = tensors[i];
-            size_t offset = offsets[i];
-            
-            // 获取实际的内存指针
-            void *basePtr = allocator.getPtr();
-            
+        // Walk the ops in execution order: an output comes alive with its
+        // producer and an input dies after its last consumer, so tensors
+        // with disjoint lifetimes reuse the same bytes via Allocator::free.
+        for (auto &op : ops) {
+            ++traceOpIndex;
+            for (auto &output : op->getOutputs()) {
+                allocRoot(rootOf.at(output.get()));
+            }
+            for (auto &input : op->getInputs()) {
+                auto &root = rootOf.at(input.get());
+                if (--remainingUses[root.get()] == 0 &&
+                    !pinned.count(root.get()) && !root->hasData()) {
+                    allocator.setTraceContext(root->getFuid(), traceOpIndex);
+                    allocator.free(offsets.at(root.get()), root->getBytes());
+                }
+            }
+        }
+
+        // 只做模拟：不申请真实内存，峰值见 allocator.getPeakBytes()
+        if (!materialize)
+        {
+            return;
+        }
+
+        // 为每个tensor绑定内存
+        void *basePtr = allocator.getPtr();
+        for (auto &tensor : tensors) {
+            if (tensor->hasData()) {
+                continue;
+            }
+            // the roots captured above, not recomputed: binding data as we
+            // go changes what aliasRootOf would report
+            auto &root = rootOf.at(tensor.get());
+
             // 计算tensor的实际内存地址
-            void *tensorPtr = static_cast<char*>(basePtr) + offset;
-            
+            void *tensorPtr;
+            auto it = offsets.find(root.get());
+            if (it != offsets.end()) {
+                tensorPtr = static_cast<char *>(basePtr) + it->second;
+            } else {
+                // aliasing a tensor with bound constant data
+                tensorPtr = root->getRawDataPtr<void *>();
+            }
+
             // 创建Blob并绑定到tensor
             auto blob = make_ref<BlobObj>(runtime, tensorPtr);
             tensor->setDataBlob(blob);
         }
-        
+
         allocator.info();
     }
 
+    double GraphObj::warmup(bool dummyRun)
+    {
+        auto start = std::chrono::steady_clock::now();
+        allocator.warmup();
+        if (dummyRun)
+        {
+            IT_ASSERT(topo_sort() == true);
+            const auto &kernelRegistry = KernelRegistry::getInstance();
+            for (auto &op : ops)
+            {
+                auto kernel = kernelRegistry.getKernel(KernelAttrs{
+                    runtime->getDevice(), op->getOpType().underlying()});
+                kernel->compute(op, runtime.get());
+            }
+        }
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    std::string GraphObj::rooflineReport(double peakGflops,
+                                         double peakGBps) const
+    {
+        const auto stats = runtime->getProfiler().aggregate();
+        std::ostringstream out;
+        out << "guid\top_type\tflops\tbytes\tintensity\tmean_ms"
+               "\tGFLOP/s\tGB/s";
+        if (peakGflops > 0 && peakGBps > 0)
+        {
+            out << "\t%peak\tbound";
+        }
+        out << "\n";
+        for (const auto &op : ops)
+        {
+            size_t flops = op->getFlops();
+            size_t bytes = op->getBytes();
+            double intensity = bytes > 0 ? (double)flops / (double)bytes : 0;
+            out << op->getGuid() << "\t" << op->getOpType().toString() << "\t"
+                << flops << "\t" << bytes << "\t" << intensity;
+            auto it = stats.find(op->getGuid());
+            if (it == stats.end())
+            {
+                out << "\t-\t-\t-";
+                if (peakGflops > 0 && peakGBps > 0)
+                {
+                    out << "\t-\t-";
+                }
+                out << "\n";
+                continue;
+            }
+            double meanMs = it->second.meanMs;
+            // flops / (ms * 1e6) = GFLOP/s; same scaling for bytes
+            double gflops = meanMs > 0 ? (double)flops / (meanMs * 1e6) : 0;
+            double gbps = meanMs > 0 ? (double)bytes / (meanMs * 1e6) : 0;
+            out << "\t" << meanMs << "\t" << gflops << "\t" << gbps;
+            if (peakGflops > 0 && peakGBps > 0)
+            {
+                // below the machine's flops-per-byte balance point the op
+                // cannot reach peak compute no matter how good the kernel:
+                // it is bandwidth-bound, and its %peak is against GB/s
+                bool bandwidthBound = intensity < peakGflops / peakGBps;
+                double pct = bandwidthBound ? 100.0 * gbps / peakGBps
+                                            : 100.0 * gflops / peakGflops;
+                out << "\t" << pct << "\t"
+                    << (bandwidthBound ? "bandwidth" : "compute");
+            }
+            out << "\n";
+        }
+        return out.str();
+    }
+
+    size_t GraphObj::dumpTensors(const std::string &dir) const
+    {
+        size_t written = 0;
+        for (const auto &tensor : tensors)
+        {
+            if (!tensor->hasData())
+            {
+                continue;
+            }
+            tensor->dumpTo(dir + "/tensor_" +
+                           std::to_string(tensor->getFuid()) + ".itsr");
+            ++written;
+        }
+        return written;
+    }
+
+    Graph GraphObj::clone() const
+    {
+        auto g = make_ref<GraphObj>(runtime);
+        std::unordered_map<TensorObj *, Tensor> tensorMap;
+        tensorMap.reserve(tensors.size());
+        for (auto &tensor : tensors)
+        {
+            auto copy = tensor->clone();
+            // weights and inputs share their payload by refcount; computed
+            // tensors must not alias the original's intermediate buffers
+            if (tensor->getSource())
+            {
+                copy->data = nullptr;
+            }
+            tensorMap.emplace(tensor.get(), g->addTensor(copy));
+        }
+        for (auto &op : ops)
+        {
+            TensorVec newInputs, newOutputs;
+            for (auto &input : op->getInputs())
+            {
+                newInputs.push_back(tensorMap.at(input.get()));
+            }
+            for (auto &output : op->getOutputs())
+            {
+                newOutputs.push_back(tensorMap.at(output.get()));
+            }
+            g->addOperatorAndConnect(op->clone(newInputs, newOutputs));
+        }
+        return g;
+    }
+
+    ExecutionPlan GraphObj::compile()
+    {
+        IT_ASSERT(topo_sort() == true);
+        auto plan = make_ref<ExecutionPlanObj>();
+        std::unordered_map<OperatorObj *, int> stepOf;
+        plan->steps.reserve(ops.size());
+        for (auto &op : ops)
+        {
+            PlanStep step;
+            // resolves through the PerfEngine, so a tuned kernel choice is
+            // baked into the plan
+            step.kernel =
+                PerfEngine::getInstance().getBestKernel(op, runtime.get());
+            // dtype and optype are fixed from here on: bake the
+            // specialized entry point so runs skip the dispatch switches,
+            // and let the kernel do one-time work (e.g. weight packing)
+            step.fn = step.kernel->specialize(op);
+            step.kernel->prepack(op, runtime.get());
+            step.op = op;
+            for (auto &input : op->getInputs())
+            {
+                IT_ASSERT(input->hasData(), "compile() requires dataMalloc()");
+                step.inputData.push_back(input->getRawDataPtr<void *>());
+            }
+            for (auto &output : op->getOutputs())
+            {
+                IT_ASSERT(output->hasData(), "compile() requires dataMalloc()");
+                step.outputData.push_back(output->getRawDataPtr<void *>());
+            }
+            stepOf[op.get()] = (int)plan->steps.size();
+            plan->steps.push_back(std::move(step));
+        }
+        // data edges from producer/consumer relationships
+        std::vector<std::set<int>> succSets(ops.size());
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            for (auto &output : ops[i]->getOutputs())
+            {
+                for (auto &succ : output->getTargets())
+                {
+                    auto it = stepOf.find(succ.get());
+                    if (it != stepOf.end())
+                    {
+                        succSets[i].insert(it->second);
+                    }
+                }
+            }
+        }
+        // Lifetime-aware dataMalloc reuses bytes across tensors whose
+        // lifetimes are disjoint in the topological order above; a later
+        // step may therefore write a buffer an earlier, data-independent
+        // step still reads or wrote. Record those hazards as extra edges
+        // so runParallel never overlaps such steps.
+        using Interval = std::pair<const char *, const char *>;
+        std::vector<std::vector<Interval>> reads(ops.size()), writes(ops.size());
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            for (auto &input : ops[i]->getInputs())
+            {
+                auto ptr = input->getRawDataPtr<char *>();
+                reads[i].emplace_back(ptr, ptr + input->getBytes());
+            }
+            for (auto &output : ops[i]->getOutputs())
+            {
+                auto ptr = output->getRawDataPtr<char *>();
+                writes[i].emplace_back(ptr, ptr + output->getBytes());
+            }
+        }
+        auto overlaps = [](const std::vector<Interval> &as,
+                           const std::vector<Interval> &bs) {
+            for (auto &a : as)
+                for (auto &b : bs)
+                    if (a.first < b.second && b.first < a.second)
+                        return true;
+            return false;
+        };
+        for (size_t j = 0; j < ops.size(); ++j)
+        {
+            for (size_t i = 0; i < j; ++i)
+            {
+                if (!succSets[i].count((int)j) &&
+                    (overlaps(writes[j], reads[i]) ||
+                     overlaps(writes[j], writes[i])))
+                {
+                    succSets[i].insert((int)j);
+                }
+            }
+        }
+        // CSR successor lists over step indices
+        plan->succOffsets.reserve(ops.size() + 1);
+        plan->succOffsets.push_back(0);
+        for (auto &succs : succSets)
+        {
+            plan->succSteps.insert(plan->succSteps.end(), succs.begin(),
+                                   succs.end());
+            plan->succOffsets.push_back((int)plan->succSteps.size());
+        }
+        plan->predCounts.assign(plan->steps.size(), 0);
+        for (auto succ : plan->succSteps)
+        {
+            ++plan->predCounts[succ];
+        }
+        return plan;
+    }
+
+    int GraphObj::chunkedBatchSize() const
+    {
+        int batch = -1;
+        for (auto &output : getOutputs())
+        {
+            IT_ASSERT(!output->getDims().empty(),
+                      "chunked execution needs a leading batch dimension");
+            if (batch < 0)
+            {
+                batch = output->getDims()[0];
+            }
+            IT_ASSERT(output->getDims()[0] == batch,
+                      "graph outputs disagree on the batch dimension");
+        }
+        IT_ASSERT(batch >= 1);
+        return batch;
+    }
+
+    Graph GraphObj::makeChunkGraph(int fullBatch, int chunkBatch) const
+    {
+        auto cg = clone();
+        for (auto &input : cg->getInputs())
+        {
+            auto dims = input->getDims();
+            if (dims.empty() || dims[0] != fullBatch)
+            {
+                // 权重等与批无关的张量：按引用计数共享原图数据，不拷贝
+                continue;
+            }
+            // 按批切分的输入：解除clone()共享的数据，让dataMalloc为它
+            // 分配chunk大小的存储
+            input->data = nullptr;
+            dims[0] = chunkBatch;
+            cg->setTensorShape(input, dims);
+        }
+        cg->shape_infer();
+        return cg;
+    }
+
+    void GraphObj::runChunked(int chunkBatch)
+    {
+        IT_ASSERT(topo_sort() == true);
+        const int fullBatch = chunkedBatchSize();
+        IT_ASSERT(chunkBatch >= 1);
+        chunkBatch = std::min(chunkBatch, fullBatch);
+
+        // 输入和权重都由调用方绑定（例如 setData 直接收养应用的缓冲区）
+        for (auto &input : getInputs())
+        {
+            IT_ASSERT(input->hasData(),
+                      "bind every graph input before runChunked");
+        }
+        // 全批输出缓冲区：未绑定的从本图自己的arena分配——中间结果都在
+        // chunk图里，这里只需要输出本身
+        {
+            std::vector<std::pair<Tensor, size_t>> pending;
+            for (auto &output : getOutputs())
+            {
+                if (!output->hasData())
+                {
+                    allocator.setTraceContext(output->getFuid(), -1);
+                    pending.emplace_back(output,
+                                         allocator.alloc(output->getBytes()));
+                }
+            }
+            if (!pending.empty())
+            {
+                char *basePtr = static_cast<char *>(allocator.getPtr());
+                for (auto &[output, offset] : pending)
+                {
+                    output->setDataBlob(
+                        make_ref<BlobObj>(runtime, basePtr + offset));
+                }
+            }
+        }
+
+        auto cg = makeChunkGraph(fullBatch, chunkBatch);
+        cg->dataMalloc();
+        auto plan = cg->compile();
+
+        // 通过fuid把整图张量和chunk图里的对应张量配对；rowBytes是第0维
+        // 上一行的字节数，dim-0切片因此是连续的memcpy
+        struct Slice
+        {
+            Tensor full;
+            Tensor chunk;
+            size_t rowBytes;
+        };
+        std::vector<Slice> chunkIns, chunkOuts;
+        for (auto &input : getInputs())
+        {
+            const auto &dims = input->getDims();
+            if (!dims.empty() && dims[0] == fullBatch)
+            {
+                chunkIns.push_back({input, cg->getTensor(input->getFuid()),
+                                    input->getBytes() / fullBatch});
+            }
+        }
+        for (auto &output : getOutputs())
+        {
+            chunkOuts.push_back({output, cg->getTensor(output->getFuid()),
+                                 output->getBytes() / fullBatch});
+        }
+
+        int current = chunkBatch;
+        for (int begin = 0; begin < fullBatch; begin += chunkBatch)
+        {
+            int n = std::min(chunkBatch, fullBatch - begin);
+            if (n != current)
+            {
+                // 尾块：原地缩小批维度。数据绑定不变（更小的形状在原来的
+                // 偏移上一定放得下），指针没变所以plan仍然有效
+                for (auto &slice : chunkIns)
+                {
+                    auto dims = slice.chunk->getDims();
+                    dims[0] = n;
+                    cg->setTensorShape(slice.chunk, dims);
+                }
+                cg->shape_infer();
+                current = n;
+            }
+            for (auto &slice : chunkIns)
+            {
+                std::memcpy(slice.chunk->getRawDataPtr<char *>(),
+                            slice.full->getRawDataPtr<char *>() +
+                                (size_t)begin * slice.rowBytes,
+                            (size_t)n * slice.rowBytes);
+            }
+            runtime->run(plan);
+            for (auto &slice : chunkOuts)
+            {
+                std::memcpy(slice.full->getRawDataPtr<char *>() +
+                                (size_t)begin * slice.rowBytes,
+                            slice.chunk->getRawDataPtr<char *>(),
+                            (size_t)n * slice.rowBytes);
+            }
+        }
+    }
+
+    int GraphObj::pickChunkBatch(size_t budgetBytes) const
+    {
+        const int fullBatch = chunkedBatchSize();
+        int best = 0;
+        for (int candidate = 1;; candidate *= 2)
+        {
+            candidate = std::min(candidate, fullBatch);
+            // 只做arena模拟，不占用真实内存
+            auto probe = makeChunkGraph(fullBatch, candidate);
+            probe->dataMalloc(false);
+            if (probe->allocator.getPeakBytes() > budgetBytes)
+            {
+                break;
+            }
+            best = candidate;
+            if (candidate == fullBatch)
+            {
+                break;
+            }
+        }
+        IT_ASSERT(best >= 1,
+                  "memory budget below even a single-row chunk arena");
+        return best;
+    }
+
     Tensor GraphObj::addTensor(Shape dim, DataType dtype)
     {
-        return tensors.emplace_back(make_ref<TensorObj>(dim, dtype, runtime));
+        auto tensor = tensors.emplace_back(std::allocate_shared<TensorObj>(
+            PoolAllocator<TensorObj>(objectPool), dim, dtype, runtime));
+        tensorSet.insert(tensor.get());
+        fuidIndex.emplace(tensor->getFuid(), tensor);
+        return tensor;
     }
 
     Tensor GraphObj::addTensor(const Tensor &tensor)
@@ -215,6 +986,10 @@ namespace infini
                       tensor->getRuntime()->toString() + " to " +
                       runtime->toString());
         tensors.emplace_back(tensor);
+        tensorSet.insert(tensor.get());
+        // cloned tensors share a fuid; a graph may hold only one of them
+        IT_ASSERT(fuidIndex.emplace(tensor->getFuid(), tensor).second,
+                  std::to_string(tensor->getFuid()));
         return tensor;
     }
 
@@ -231,46 +1006,41 @@ namespace infini
     // "predecessors" and "successors" of an operator of "ops" must be in "ops".
     bool GraphObj::checkValid() const
     {
+        // membership tests go through the guid/pointer indexes, so the whole
+        // validation is linear in the number of edges
         for (auto tensor : tensors)
         {
             IT_ASSERT(!(tensor->getTargets().size() == 0 &&
                         nullptr == tensor->getSource()));
             for (auto op : tensor->getTargets())
             {
-                IT_ASSERT(std::find(ops.begin(), ops.end(), op) != ops.end());
+                IT_ASSERT(opIndex.count(op->getGuid()));
             }
             auto op = tensor->getSource();
-            IT_ASSERT(!(op && std::find(ops.begin(), ops.end(), op) == ops.end()));
+            IT_ASSERT(!(op && !opIndex.count(op->getGuid())));
         }
         for (auto op : ops)
         {
             for (auto tensor : op->getInputs())
             {
-                IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
-                          tensors.end());
+                IT_ASSERT(tensorSet.count(tensor.get()));
             }
             for (auto tensor : op->getOutputs())
             {
-                IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
-                          tensors.end());
+                IT_ASSERT(tensorSet.count(tensor.get()));
             }
             for (auto pre : op->getPredecessors())
             {
-                IT_ASSERT(std::find(ops.begin(), ops.end(), pre) != ops.end());
+                IT_ASSERT(opIndex.count(pre->getGuid()));
             }
             for (auto suc : op->getSuccessors())
             {
-                IT_ASSERT(std::find(ops.begin(), ops.end(), suc) != ops.end());
+                IT_ASSERT(opIndex.count(suc->getGuid()));
             }
         }
-        std::set<UidBaseType> s;
-        // check whether two tensors with the same FUID exist
-        for (auto tensor : tensors)
-        {
-            int cnt = s.count(tensor->getFuid());
-            IT_ASSERT(cnt == 0, std::to_string(tensor->getFuid()));
-            s.insert(tensor->getFuid());
-        }
+        // two tensors with the same FUID cannot coexist: the fuid index
+        // keeps one entry per fuid, so matching sizes imply uniqueness
+        IT_ASSERT(fuidIndex.size() == tensors.size());
         return true;
     }
 
@@ -289,134 +1059,233 @@ namespace infini
         return true;
     }
 
-    bool GraphObj::removeRedundantTranspose()
+    bool GraphObj::rewriteFoldConstant(const Operator &op, OpVec &affected)
     {
-        bool changed = false;
-
-        // 使用索引遍历避免迭代器失效
-        for (size_t i = 0; i < ops.size();) {
-            auto op = ops[i];
-
-            // 检查是否为transpose算子
-            if (op->getOpType() != OpType::Transpose) {
-                ++i;
-                continue;
+        // 所有输入都必须是已绑定常量数据的图输入（权重）
+        for (auto &input : op->getInputs()) {
+            if (!input || input->getSource() || !input->hasData()) {
+                return false;
             }
+        }
 
-            auto transposeOp = as<TransposeObj>(op);
-            auto output = transposeOp->getOutput();
+        // 在优化期通过注册的CPU kernel把这个算子执行一次
+        for (auto &output : op->getOutputs()) {
+            if (!output->hasData()) {
+                output->setDataBlob(make_ref<BlobObj>(
+                    runtime, runtime->alloc(output->getBytes())));
+            }
+        }
+        const auto &kernelRegistry = KernelRegistry::getInstance();
+        auto kernelAttrs =
+            KernelAttrs{runtime->getDevice(), op->getOpType().underlying()};
+        Kernel *kernel = kernelRegistry.getKernel(kernelAttrs);
+        kernel->compute(op, runtime.get());
 
-            // 检查是否只有一个后继且也是transpose
-            if (output->getTargets().size() == 1) {
-                auto nextOp = output->getTargets()[0];
-                if (nextOp->getOpType() == OpType::Transpose) {
-                    auto nextTranspose = as<TransposeObj>(nextOp);
+        // 输出成为无source的预计算常量，其消费者可能接着被折叠
+        for (auto &output : op->getOutputs()) {
+            output->setSource(nullptr);
+            for (auto &target : output->getTargets()) {
+                affected.push_back(target);
+            }
+        }
+        auto inputs = op->getInputs();
+        removeOperatorfromGraph(op);
+        // 不再被任何算子读取的常量输入一并移除
+        for (auto &input : inputs) {
+            input->removeTarget(op);
+            if (input->getTargets().empty()) {
+                removeTensor(input);
+            }
+        }
+        return true;
+    }
 
-                    // 检查两个transpose是否互为逆操作
-                    auto perm1 = transposeOp->getPermute();
-                    auto perm2 = nextTranspose->getPermute();
+    bool GraphObj::rewriteTransposePair(const Operator &op, OpVec &affected)
+    {
+        auto transposeOp = as<TransposeObj>(op);
+        auto output = transposeOp->getOutput();
 
-                    if (isInversePermutation(perm1, perm2)) {
-                        // 移除这两个transpose算子
-                        auto input = transposeOp->getInputs()[0];
-                        auto finalOutput = nextTranspose->getOutput();
+        // 检查是否只有一个后继且也是transpose
+        if (output->getTargets().size() != 1) {
+            return false;
+        }
+        auto nextOp = output->getTargets()[0];
+        if (nextOp->getOpType() != OpType::Transpose) {
+            return false;
+        }
+        auto nextTranspose = as<TransposeObj>(nextOp);
 
-                        // 重新连接输入到最终输出
-                        reconnectTensors(input, finalOutput);
+        // 检查两个transpose是否互为逆操作
+        if (!isInversePermutation(transposeOp->getPermute(),
+                                  nextTranspose->getPermute())) {
+            return false;
+        }
 
-                        // 从图中移除算子和中间tensor
-                   
-                        removeOperatorfromGraph(op);
-                        removeOperatorfromGraph(nextOp);
-                        removeTensor(output);
-                        removeTensor(finalOutput);
+        auto input = transposeOp->getInputs()[0];
+        auto finalOutput = nextTranspose->getOutput();
 
-                        changed = true;
-                        i = 0; // 重新开始遍历
-                        continue;
-                    }
-                }
+        // 将transpose对的消费者重定向到原始输入
+        input->removeTarget(op);
+        for (auto &target : finalOutput->getTargets()) {
+            target->replaceInput(finalOutput, input);
+            input->addTarget(target);
+            if (auto source = input->getSource()) {
+                source->addSuccessors(target);
+                target->addPredecessors(source);
             }
-            ++i;
+            // the consumer now reads a new producer; its own patterns may
+            // have become matchable
+            affected.push_back(target);
         }
 
-        topo_sort();
-
-        return changed;
+        // 从图中移除算子和中间tensor
+        removeOperatorfromGraph(op);
+        removeOperatorfromGraph(nextOp);
+        removeTensor(output);
+        removeTensor(finalOutput);
+        if (auto source = input->getSource()) {
+            affected.push_back(source);
+        }
+        return true;
     }
 
-    bool GraphObj::fuseTransposeIntoMatmul()
+    bool GraphObj::rewriteTransposeIntoMatmul(const Operator &op, OpVec &affected)
     {
-        bool changed = false;
-
-        // 使用索引遍历避免迭代器失效
-        for (size_t i = 0; i < ops.size(); ++i) {
-            auto op = ops[i];
-            if (op->getOpType() != OpType::MatMul) {
+        auto matmulOp = as<MatmulObj>(op);
+        for (int side = 0; side < 2; ++side) {
+            auto input = matmulOp->getInputs(side);
+            auto source = input->getSource();
+            if (!source || source->getOpType() != OpType::Transpose) {
+                continue;
+            }
+            auto transposeOp = as<TransposeObj>(source);
+            if (!isLastTwoDimTranspose(transposeOp->getPermute(),
+                                       input->getRank())) {
                 continue;
             }
 
-            auto matmulOp = as<MatmulObj>(op);
-            auto inputA = matmulOp->getInputs()[0];
-            auto inputB = matmulOp->getInputs()[1];
+            // 融入transA/transB属性
+            auto transposeIn = transposeOp->getInputs()[0];
+            auto newMatmul = make_ref<MatmulObj>(
+                nullptr,
+                side == 0 ? transposeIn : matmulOp->getInputs(0),
+                side == 0 ? matmulOp->getInputs(1) : transposeIn,
+                matmulOp->getOutput(),
+                side == 0 ? !matmulOp->getTransA() : matmulOp->getTransA(),
+                side == 1 ? !matmulOp->getTransB() : matmulOp->getTransB());
 
-            bool fusedA = false, fusedB = false;
+            // 先拆除旧matmul，再接入新算子
+            for (auto &in : matmulOp->getInputs()) {
+                in->removeTarget(op);
+            }
+            removeOperatorfromGraph(op);
+            // 只有当transpose没有其他用户时才移除
+            if (input->getTargets().empty()) {
+                transposeIn->removeTarget(source);
+                removeOperatorfromGraph(source);
+                removeTensor(input);
+            }
+            addOperatorAndConnect(newMatmul);
 
-            // 检查输入A是否来自transpose
-            if (auto sourceA = inputA->getSource()) {
-                if (sourceA->getOpType() == OpType::Transpose) {
-                    auto transposeA = as<TransposeObj>(sourceA);
-                    if (isLastTwoDimTranspose(transposeA->getPermute(), inputA->getRank())) {
-                        // 融入transA属性
-                        auto newMatmul = make_ref<MatmulObj>(nullptr,
-                            transposeA->getInputs()[0], inputB, matmulOp->getOutput(),
-                            !matmulOp->getTransA(), matmulOp->getTransB());
+            // the new matmul may have a fusible transpose on its other input
+            affected.push_back(newMatmul);
+            return true;
+        }
+        return false;
+    }
 
-                        replaceOperator(matmulOp, newMatmul);
+    bool GraphObj::rewriteQuantizedMatmul(const Operator &op, OpVec &affected)
+    {
+        auto matmulOp = as<MatmulObj>(op);
+        // 两个输入都必须来自zeroPoint为0的int8 DequantizeLinear算子
+        Ref<DequantizeLinearObj> dq[2];
+        for (int side = 0; side < 2; ++side) {
+            auto source = matmulOp->getInputs(side)->getSource();
+            if (!source || source->getOpType() != OpType::DequantizeLinear) {
+                return false;
+            }
+            dq[side] = as<DequantizeLinearObj>(source);
+            // asymmetric zero points would add cross terms to the product;
+            // only the symmetric case folds into a single output scale
+            if (dq[side]->getZeroPoint() != 0 ||
+                !(dq[side]->getInputs(0)->getDType() == DataType::Int8)) {
+                return false;
+            }
+        }
 
-                        // 只有当transpose没有其他用户时才移除
-                        if (inputA->getTargets().size() == 1) {
-                            removeOperatorfromGraph(sourceA);
-                            removeTensor(inputA);
-                        }
+        // int8矩阵乘累加到int32, 再用两个scale的乘积一次性反量化
+        auto qA = dq[0]->getInputs(0), qB = dq[1]->getInputs(0);
+        auto acc = addTensor(matmulOp->getOutput()->getDims(), DataType::Int32);
+        auto newMatmul = make_ref<MatmulObj>(
+            nullptr, qA, qB, acc,
+            matmulOp->getTransA(), matmulOp->getTransB());
+        auto newDequant = make_ref<DequantizeLinearObj>(
+            nullptr, acc, matmulOp->getOutput(),
+            dq[0]->getScale() * dq[1]->getScale());
 
-                        fusedA = true;
-                        changed = true;
-                    }
-                }
+        // 先拆除旧matmul，再接入新算子
+        for (auto &in : matmulOp->getInputs()) {
+            in->removeTarget(op);
+        }
+        removeOperatorfromGraph(op);
+        // 只有当dequantize没有其他用户时才移除（两侧可能是同一个算子）
+        for (int side = 0; side < 2; ++side) {
+            if (side == 1 && dq[1] == dq[0]) {
+                break;
             }
-
-            auto sourceB = inputB->getSource();
-            // 检查输入B是否来自transpose（如果A没有被融合）
-            if (!fusedA &&  sourceB) {
-                if (sourceB->getOpType() == OpType::Transpose) {
-                    auto transposeB = as<TransposeObj>(sourceB);
-                    if (isLastTwoDimTranspose(transposeB->getPermute(), inputB->getRank())) {
-                        // 融入transB属性
-                        
-                        auto inputtransposeB = transposeB->getInputs()[0];
-                        inputtransposeB->removeTarget(transposeB);
-                        auto newMatmul = make_ref<MatmulObj>(nullptr,
-                            inputA, inputtransposeB, matmulOp->getOutput(),
-                            matmulOp->getTransA(), !matmulOp->getTransB());
-                                              
-                        inputtransposeB->addTarget(newMatmul);
-                        replaceOperator(matmulOp, newMatmul);
-                                              
-                        // 只有当transpose没有其他用户时才移除
-                        if (inputB->getTargets().size() == 1) {
-                            
-                            removeOperatorfromGraph(sourceB);
-                            removeTensor(inputB);
-                        }
-                        
-                        changed = true;
-                    }
-                }
+            auto dqOut = dq[side]->getOutput();
+            if (dqOut->getTargets().empty()) {
+                dq[side]->getInputs(0)->removeTarget(dq[side]);
+                removeOperatorfromGraph(dq[side]);
+                removeTensor(dqOut);
             }
         }
+        addOperatorAndConnect(newMatmul);
+        addOperatorAndConnect(newDequant);
 
-        return changed;
+        // the int8 matmul may still have fusible transposes on its inputs
+        affected.push_back(newMatmul);
+        affected.push_back(newDequant);
+        return true;
+    }
+
+    bool GraphObj::rewriteElementWiseActivation(const Operator &op, OpVec &affected)
+    {
+        auto elemType = op->getOpType();
+        auto intermediate = op->getOutput();
+        // 中间tensor只能被激活算子消费，否则无法删除
+        if (intermediate->getTargets().size() != 1) {
+            return false;
+        }
+        auto act = intermediate->getTargets()[0];
+        auto actType = act->getOpType();
+        if (actType != OpType::Relu && actType != OpType::Clip) {
+            return false;
+        }
+
+        std::optional<float> minValue, maxValue;
+        if (actType == OpType::Clip) {
+            auto clip = as<ClipObj>(act);
+            minValue = clip->getMin();
+            maxValue = clip->getMax();
+        }
+
+        auto fused = make_ref<FusedElemActObj>(
+            nullptr, elemType, actType, op->getInputs(0), op->getInputs(1),
+            act->getOutput(), minValue, maxValue);
+
+        // 先拆除旧的算子对和中间tensor，再接入融合算子
+        for (auto &input : op->getInputs()) {
+            input->removeTarget(op);
+        }
+        intermediate->removeTarget(act);
+        removeOperatorfromGraph(op);
+        removeOperatorfromGraph(act);
+        removeTensor(intermediate);
+        addOperatorAndConnect(fused);
+
+        affected.push_back(fused);
+        return true;
     }
 
     bool GraphObj::isInversePermutation(const vector<int>& perm1, const vector<int>& perm2)
@@ -447,53 +1316,4 @@ namespace infini
         return perm[rank-2] == rank-1 && perm[rank-1] == rank-2;
     }
 
-    void GraphObj::reconnectTensors(Tensor from, Tensor to)
-    {
-        // 复制目标列表避免在迭代时修改
-        auto targets = to->getTargets();
-        for (auto target : from->getTargets())
-        {
-            from->removeTarget(target);
-        }
-        // 将from的所有目标重定向到to
-        for (auto target : targets) {
-            target->replaceInput(to, from);
-            from->addTarget(target);
-            to->removeTarget(target);
-        }
-
-    }
-
-    void GraphObj::replaceOperator(Operator oldOp, Operator newOp)
-    {
-        // 替换ops列表中的算子
-        auto it = std::find(ops.begin(), ops.end(), oldOp);
-        if (it != ops.end()) {
-            *it = newOp;
-        }
-
-        // 更新输入tensor的目标连接
-        for (auto input : oldOp->getInputs()) {
-            if (input) {
-                input->removeTarget(oldOp);
-                input->addTarget(newOp);
-                if (auto source = input->getSource()) {
-                    source->addSuccessors(newOp);
-                    newOp->addPredecessors(source);
-                }
-            }
-        }
-
-        // 更新输出tensor的source
-        for (auto output : oldOp->getOutputs()) {
-            if (output) {
-                output->setSource(newOp);
-                for (auto target : output->getTargets()) {
-                    target->addPredecessors(newOp);
-                    newOp->addSuccessors(target);
-                }
-            }
-        }
-    }
-
 } // namespace infini
@@ -0,0 +1,482 @@
+#include "core/blob.h"
+#include "core/graph.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/quantize.h"
+#include "operators/reshape.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+#include <cstring>
+#include <fstream>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace infini
+{
+    // model file layout: the header below, then a variable-length graph
+    // section, then — page-aligned so it can be mmap'ed and demand-paged —
+    // the weight section with every data-bearing tensor's payload at a
+    // 64-byte-aligned offset. Host-endian, like the tensor dumps.
+    //
+    // graph section encoding (all integers 4 bytes):
+    //   per tensor: fuid, dtype index, rank, dims..., weight offset (-1
+    //               when the tensor has no data), payload bytes
+    //   per op:     OpType underlying, #inputs, input fuids..., #outputs,
+    //               output fuids..., #attrs, attrs... (per-type, see
+    //               attrsOf/buildOp)
+    namespace
+    {
+        struct ModelHeader
+        {
+            char magic[4]; // "ITMF"
+            uint32_t version;
+            uint32_t numTensors;
+            uint32_t numOps;
+            uint64_t weightOffset;
+            uint64_t weightBytes;
+        };
+
+        constexpr size_t modelPageSize = 4096;
+        constexpr size_t weightAlignment = 64;
+
+        void appendI32(std::string &out, int32_t v)
+        {
+            out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+        }
+
+        int32_t readI32(const char *&cursor)
+        {
+            int32_t v;
+            std::memcpy(&v, cursor, sizeof(v));
+            cursor += sizeof(v);
+            return v;
+        }
+
+        int32_t floatBits(float f)
+        {
+            int32_t v;
+            std::memcpy(&v, &f, sizeof(v));
+            return v;
+        }
+
+        float bitsFloat(int32_t v)
+        {
+            float f;
+            std::memcpy(&f, &v, sizeof(f));
+            return f;
+        }
+
+        void appendOptFloat(std::string &out, const std::optional<float> &f)
+        {
+            appendI32(out, f.has_value());
+            appendI32(out, f ? floatBits(*f) : 0);
+        }
+
+        std::optional<float> readOptFloat(const char *&cursor)
+        {
+            bool has = readI32(cursor);
+            int32_t bits = readI32(cursor);
+            return has ? std::optional<float>(bitsFloat(bits)) : std::nullopt;
+        }
+
+        // the per-type attribute payload; buildOp is its inverse
+        std::string attrsOf(const Operator &op)
+        {
+            std::string out;
+            switch (op->getOpType().underlying())
+            {
+            case OpType::Add:
+            case OpType::Sub:
+            case OpType::Mul:
+            case OpType::Div:
+            case OpType::Relu:
+            case OpType::Identity:
+                break;
+            case OpType::MatMul:
+            {
+                auto matmul = as<MatmulObj>(op);
+                appendI32(out, matmul->getTransA());
+                appendI32(out, matmul->getTransB());
+                break;
+            }
+            case OpType::Concat:
+                appendI32(out, as<ConcatObj>(op)->getDim());
+                break;
+            case OpType::Transpose:
+                for (int p : as<TransposeObj>(op)->getPermute())
+                {
+                    appendI32(out, p);
+                }
+                break;
+            case OpType::Clip:
+            {
+                auto clip = as<ClipObj>(op);
+                appendOptFloat(out, clip->getMin());
+                appendOptFloat(out, clip->getMax());
+                break;
+            }
+            case OpType::Cast:
+                appendI32(out, (int32_t)as<CastObj>(op)->getType());
+                break;
+            case OpType::FusedElemAct:
+            {
+                auto fused = as<FusedElemActObj>(op);
+                appendI32(out, fused->getElemType().underlying());
+                appendI32(out, fused->getActType().underlying());
+                appendOptFloat(out, fused->getMin());
+                appendOptFloat(out, fused->getMax());
+                break;
+            }
+            case OpType::Reshape:
+                for (auto d : as<ReshapeObj>(op)->getDims())
+                {
+                    appendI32(out, d);
+                }
+                break;
+            case OpType::Flatten:
+                appendI32(out, as<FlattenObj>(op)->getAxis());
+                break;
+            case OpType::QuantizeLinear:
+            {
+                auto quant = as<QuantizeLinearObj>(op);
+                appendI32(out, floatBits(quant->getScale()));
+                appendI32(out, quant->getZeroPoint());
+                break;
+            }
+            case OpType::DequantizeLinear:
+            {
+                auto dequant = as<DequantizeLinearObj>(op);
+                appendI32(out, floatBits(dequant->getScale()));
+                appendI32(out, dequant->getZeroPoint());
+                break;
+            }
+            default:
+                IT_ASSERT(false, std::string("cannot serialize op type ") +
+                                     op->getOpType().toString());
+            }
+            return out;
+        }
+    } // namespace
+
+    void GraphObj::save(const std::string &path) const
+    {
+        // pass 1: lay the weight section out. Only sourceless tensors
+        // (inputs, weights, folded constants) are captured: computed
+        // tensors are rebuilt by running the loaded graph, and must not
+        // end up bound to the read-only mapping a kernel would then
+        // write through
+        std::unordered_map<UidBaseType, std::pair<int64_t, size_t>> layout;
+        size_t weightBytes = 0;
+        for (const auto &t : tensors)
+        {
+            // the file records dense row-major payloads and no view
+            // metadata, so a slice/narrow/squeeze view cannot be saved:
+            // a strided one would serialize the wrong bytes, a dense one
+            // would duplicate its storage tensor and reload detached
+            // from it. Fail loudly, like dumpTo does
+            IT_ASSERT(!t->isView(),
+                      "cannot save a graph holding tensor views; save the "
+                      "storage tensors and re-slice after loading");
+            if (!t->hasData() || t->getSource())
+            {
+                continue;
+            }
+            weightBytes =
+                (weightBytes + weightAlignment - 1) & ~(weightAlignment - 1);
+            layout[t->getFuid()] = {(int64_t)weightBytes, t->getBytes()};
+            weightBytes += t->getBytes();
+        }
+
+        // pass 2: the graph section
+        std::string section;
+        for (const auto &t : tensors)
+        {
+            appendI32(section, (int32_t)t->getFuid());
+            appendI32(section, t->getDType().getIndex());
+            const auto &dims = t->getDims();
+            appendI32(section, (int32_t)dims.size());
+            for (auto d : dims)
+            {
+                appendI32(section, d);
+            }
+            auto it = layout.find(t->getFuid());
+            appendI32(section,
+                      it == layout.end() ? -1 : (int32_t)it->second.first);
+            appendI32(section,
+                      it == layout.end() ? 0 : (int32_t)it->second.second);
+        }
+        for (const auto &op : ops)
+        {
+            appendI32(section, op->getOpType().underlying());
+            appendI32(section, op->numInputs());
+            for (const auto &t : op->getInputs())
+            {
+                appendI32(section, (int32_t)t->getFuid());
+            }
+            appendI32(section, op->numOutputs());
+            for (const auto &t : op->getOutputs())
+            {
+                appendI32(section, (int32_t)t->getFuid());
+            }
+            auto attrs = attrsOf(op);
+            appendI32(section, (int32_t)(attrs.size() / sizeof(int32_t)));
+            section += attrs;
+        }
+
+        size_t weightOffset = sizeof(ModelHeader) + section.size();
+        weightOffset =
+            (weightOffset + modelPageSize - 1) & ~(modelPageSize - 1);
+
+        std::ofstream out(path, std::ios::binary);
+        IT_ASSERT(out.good(), "cannot open " + path + " for writing");
+        ModelHeader header{{'I', 'T', 'M', 'F'},
+                           1,
+                           (uint32_t)tensors.size(),
+                           (uint32_t)ops.size(),
+                           weightOffset,
+                           weightBytes};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(section.data(), section.size());
+        for (const auto &t : tensors)
+        {
+            auto it = layout.find(t->getFuid());
+            if (it == layout.end())
+            {
+                continue;
+            }
+            out.seekp(weightOffset + it->second.first);
+            out.write(t->getRawDataPtr<const char *>(), it->second.second);
+        }
+        // pad so the file covers the whole last weight page
+        out.seekp(0, std::ios::end);
+        if ((size_t)out.tellp() < weightOffset + weightBytes)
+        {
+            out.seekp(weightOffset + weightBytes - 1);
+            out.put('\0');
+        }
+        IT_ASSERT(out.good(), "failed writing " + path);
+    }
+
+    Graph GraphObj::load(Runtime runtime, const std::string &path)
+    {
+        // map (or, off Linux, read) the whole file; weights are bound
+        // straight into this buffer, so it is kept alive by the graph
+        std::shared_ptr<void> mapping;
+        const char *base = nullptr;
+        size_t fileBytes = 0;
+#ifdef __linux__
+        int fd = open(path.c_str(), O_RDONLY);
+        IT_ASSERT(fd >= 0, "cannot open " + path);
+        struct stat st;
+        IT_ASSERT(fstat(fd, &st) == 0);
+        fileBytes = (size_t)st.st_size;
+        void *mapped =
+            mmap(nullptr, fileBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        IT_ASSERT(mapped != MAP_FAILED, "cannot map " + path);
+        mapping = std::shared_ptr<void>(
+            mapped, [fileBytes](void *p) { munmap(p, fileBytes); });
+        base = static_cast<const char *>(mapped);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        IT_ASSERT(in.good(), "cannot open " + path);
+        fileBytes = (size_t)in.tellg();
+        in.seekg(0);
+        auto buffer = std::make_shared<std::vector<char>>(fileBytes);
+        in.read(buffer->data(), fileBytes);
+        IT_ASSERT(in.good(), "failed reading " + path);
+        mapping = std::shared_ptr<void>(buffer, buffer->data());
+        base = buffer->data();
+#endif
+
+        IT_ASSERT(fileBytes >= sizeof(ModelHeader));
+        ModelHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        IT_ASSERT(std::memcmp(header.magic, "ITMF", 4) == 0 &&
+                      header.version == 1,
+                  path + " is not a model file");
+        IT_ASSERT(fileBytes >= header.weightOffset + header.weightBytes,
+                  "truncated model file " + path);
+
+        Graph graph = make_ref<GraphObj>(runtime);
+        const char *cursor = base + sizeof(header);
+        const char *weights = base + header.weightOffset;
+
+        std::unordered_map<int32_t, Tensor> byFuid;
+        for (uint32_t i = 0; i < header.numTensors; ++i)
+        {
+            int32_t fuid = readI32(cursor);
+            DataType dtype((int)readI32(cursor));
+            int32_t rank = readI32(cursor);
+            Shape dims;
+            for (int32_t d = 0; d < rank; ++d)
+            {
+                dims.push_back(readI32(cursor));
+            }
+            int32_t weightOff = readI32(cursor);
+            int32_t bytes = readI32(cursor);
+
+            auto tensor = graph->addTensor(dims, dtype);
+            if (weightOff >= 0)
+            {
+                // zero-copy: the tensor reads the mapped (or buffered)
+                // page cache directly
+                tensor->setData(const_cast<char *>(weights) + weightOff,
+                                (size_t)bytes);
+            }
+            byFuid[fuid] = tensor;
+        }
+
+        auto tensorAt = [&](int32_t fuid)
+        {
+            auto it = byFuid.find(fuid);
+            IT_ASSERT(it != byFuid.end(),
+                      "op references unknown tensor in " + path);
+            return it->second;
+        };
+
+        for (uint32_t i = 0; i < header.numOps; ++i)
+        {
+            OpType opType((OpType::underlying_t)readI32(cursor));
+            TensorVec inputs, outputs;
+            int32_t nInputs = readI32(cursor);
+            for (int32_t j = 0; j < nInputs; ++j)
+            {
+                inputs.push_back(tensorAt(readI32(cursor)));
+            }
+            int32_t nOutputs = readI32(cursor);
+            for (int32_t j = 0; j < nOutputs; ++j)
+            {
+                outputs.push_back(tensorAt(readI32(cursor)));
+            }
+            int32_t nAttrs = readI32(cursor);
+            const char *attrsEnd = cursor + nAttrs * sizeof(int32_t);
+
+            switch (opType.underlying())
+            {
+            case OpType::Add:
+                graph->addOpWithOutputs<AddObj>(inputs[0], inputs[1],
+                                                outputs[0]);
+                break;
+            case OpType::Sub:
+                graph->addOpWithOutputs<SubObj>(inputs[0], inputs[1],
+                                                outputs[0]);
+                break;
+            case OpType::Mul:
+                graph->addOpWithOutputs<MulObj>(inputs[0], inputs[1],
+                                                outputs[0]);
+                break;
+            case OpType::Div:
+                graph->addOpWithOutputs<DivObj>(inputs[0], inputs[1],
+                                                outputs[0]);
+                break;
+            case OpType::Relu:
+                graph->addOpWithOutputs<ReluObj>(inputs[0], outputs[0]);
+                break;
+            case OpType::Identity:
+                graph->addOpWithOutputs<IdentityObj>(inputs[0], outputs[0]);
+                break;
+            case OpType::MatMul:
+            {
+                bool transA = readI32(cursor);
+                bool transB = readI32(cursor);
+                graph->addOpWithOutputs<MatmulObj>(inputs[0], inputs[1],
+                                                   outputs[0], transA,
+                                                   transB);
+                break;
+            }
+            case OpType::Concat:
+            {
+                int dim = readI32(cursor);
+                graph->addOpWithOutputs<ConcatObj>(inputs, outputs[0], dim);
+                break;
+            }
+            case OpType::Transpose:
+            {
+                std::vector<int> permute(nAttrs);
+                for (int32_t j = 0; j < nAttrs; ++j)
+                {
+                    permute[j] = readI32(cursor);
+                }
+                graph->addOpWithOutputs<TransposeObj>(inputs[0], outputs[0],
+                                                      permute);
+                break;
+            }
+            case OpType::Clip:
+            {
+                auto min = readOptFloat(cursor);
+                auto max = readOptFloat(cursor);
+                graph->addOpWithOutputs<ClipObj>(inputs[0], outputs[0], min,
+                                                 max);
+                break;
+            }
+            case OpType::Cast:
+            {
+                auto castType = (CastType)readI32(cursor);
+                graph->addOpWithOutputs<CastObj>(inputs[0], outputs[0],
+                                                 castType);
+                break;
+            }
+            case OpType::FusedElemAct:
+            {
+                OpType elemType((OpType::underlying_t)readI32(cursor));
+                OpType actType((OpType::underlying_t)readI32(cursor));
+                auto min = readOptFloat(cursor);
+                auto max = readOptFloat(cursor);
+                graph->addOpWithOutputs<FusedElemActObj>(
+                    elemType, actType, inputs[0], inputs[1], outputs[0], min,
+                    max);
+                break;
+            }
+            case OpType::Reshape:
+            {
+                Shape dims;
+                for (int32_t j = 0; j < nAttrs; ++j)
+                {
+                    dims.push_back(readI32(cursor));
+                }
+                graph->addOpWithOutputs<ReshapeObj>(inputs[0], outputs[0],
+                                                    dims);
+                break;
+            }
+            case OpType::Flatten:
+            {
+                int axis = readI32(cursor);
+                graph->addOpWithOutputs<FlattenObj>(inputs[0], outputs[0],
+                                                    axis);
+                break;
+            }
+            case OpType::QuantizeLinear:
+            {
+                float scale = bitsFloat(readI32(cursor));
+                int zeroPoint = readI32(cursor);
+                graph->addOpWithOutputs<QuantizeLinearObj>(inputs[0],
+                                                           outputs[0], scale,
+                                                           zeroPoint);
+                break;
+            }
+            case OpType::DequantizeLinear:
+            {
+                float scale = bitsFloat(readI32(cursor));
+                int zeroPoint = readI32(cursor);
+                graph->addOpWithOutputs<DequantizeLinearObj>(inputs[0],
+                                                             outputs[0], scale,
+                                                             zeroPoint);
+                break;
+            }
+            default:
+                IT_ASSERT(false, std::string("cannot load op type ") +
+                                     opType.toString());
+            }
+            IT_ASSERT(cursor == attrsEnd, "attr size mismatch in " + path);
+        }
+
+        graph->weightMapping = std::move(mapping);
+        return graph;
+    }
+} // namespace infini
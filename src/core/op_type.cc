@@ -21,6 +21,12 @@ namespace infini
             CASE(Transpose);
             CASE(Concat);
             CASE(MatMul);
+            CASE(FusedElemAct);
+            CASE(Reshape);
+            CASE(Flatten);
+            CASE(Identity);
+            CASE(QuantizeLinear);
+            CASE(DequantizeLinear);
 
         default:
             return "Unknown";
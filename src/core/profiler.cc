@@ -0,0 +1,127 @@
+#include "core/profiler.h"
+#include "core/operator.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace infini
+{
+    namespace
+    {
+        struct Stats
+        {
+            size_t count;
+            double minMs, meanMs, p99Ms;
+        };
+
+        Stats summarize(std::vector<double> samples)
+        {
+            std::sort(samples.begin(), samples.end());
+            double sum = 0;
+            for (auto s : samples)
+                sum += s;
+            size_t n = samples.size();
+            size_t p99Index =
+                (size_t)std::ceil(0.99 * (double)n) == 0
+                    ? 0
+                    : (size_t)std::ceil(0.99 * (double)n) - 1;
+            return Stats{n, samples.front(), sum / (double)n,
+                         samples[p99Index]};
+        }
+    } // namespace
+
+    void Profiler::record(const Ref<OperatorObj> &op, double ms)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto &rec = records[op->getGuid()];
+        if (rec.samplesMs.empty())
+        {
+            rec.opType = op->getOpType().toString();
+        }
+        rec.samplesMs.push_back(ms);
+    }
+
+    void Profiler::endRun()
+    {
+        std::string path;
+        bool json = false;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++runs;
+            if (dumpEvery == 0 || runs % dumpEvery != 0)
+            {
+                return;
+            }
+            path = dumpPath;
+            json = path.size() >= 5 &&
+                   path.compare(path.size() - 5, 5, ".json") == 0;
+        }
+        std::ofstream out(path);
+        out << (json ? toJson() : toCsv());
+    }
+
+    void Profiler::setAutoDump(uint64_t everyNRuns, const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        dumpEvery = everyNRuns;
+        dumpPath = path;
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        records.clear();
+        runs = 0;
+    }
+
+    uint64_t Profiler::numRuns() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return runs;
+    }
+
+    std::map<UidBaseType, Profiler::OpStat> Profiler::aggregate() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::map<UidBaseType, OpStat> stats;
+        for (const auto &[guid, rec] : records)
+        {
+            auto s = summarize(rec.samplesMs);
+            stats.emplace(guid, OpStat{rec.opType, s.count, s.minMs, s.meanMs,
+                                       s.p99Ms});
+        }
+        return stats;
+    }
+
+    std::string Profiler::toCsv() const
+    {
+        std::ostringstream out;
+        out << "guid,op_type,count,min_ms,mean_ms,p99_ms\n";
+        for (const auto &[guid, s] : aggregate())
+        {
+            out << guid << "," << s.opType << "," << s.count << "," << s.minMs
+                << "," << s.meanMs << "," << s.p99Ms << "\n";
+        }
+        return out.str();
+    }
+
+    std::string Profiler::toJson() const
+    {
+        std::ostringstream out;
+        out << "[";
+        bool first = true;
+        for (const auto &[guid, s] : aggregate())
+        {
+            out << (first ? "" : ",") << "\n  {\"guid\": " << guid
+                << ", \"op_type\": \"" << s.opType
+                << "\", \"count\": " << s.count << ", \"min_ms\": " << s.minMs
+                << ", \"mean_ms\": " << s.meanMs << ", \"p99_ms\": " << s.p99Ms
+                << "}";
+            first = false;
+        }
+        out << "\n]\n";
+        return out.str();
+    }
+
+} // namespace infini
@@ -2,21 +2,269 @@
 #include "core/blob.h"
 #include "core/kernel.h"
 #include "core/graph.h"
-#include "core/kernel.h"
+#include "core/perf_engine.h"
+#include "core/plan.h"
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
+#include <mutex>
 namespace infini
 {
+    // one indirect call into the plan-time specialized instantiation when
+    // the kernel provided one, the generic virtual path otherwise
+    static inline void dispatch(const PlanStep &step, const RuntimeObj *rt)
+    {
+        if (step.fn)
+        {
+            step.fn(step.op, rt);
+        }
+        else
+        {
+            step.kernel->compute(step.op, rt);
+        }
+    }
+
     void NativeCpuRuntimeObj::run(const Graph &graph) const
     {
-        const auto &kernelRegistry = KernelRegistry::getInstance();
+        auto &perfEngine = PerfEngine::getInstance();
 
+        std::chrono::steady_clock::time_point runBegin;
+        if (hooks.graphEnd)
+        {
+            runBegin = std::chrono::steady_clock::now();
+        }
+        if (hooks.graphBegin)
+        {
+            hooks.graphBegin(hooks.ctx);
+        }
         for (auto &op : graph->getOperators())
         {
-            auto kernelAttrs = KernelAttrs{device, op->getOpType().underlying()};
-            Kernel *kernel = kernelRegistry.getKernel(kernelAttrs);
+            Kernel *kernel = perfEngine.getBestKernel(op, this);
+            if (hooks.preOp)
+            {
+                hooks.preOp(hooks.ctx, op);
+            }
+            if (!profiling && !hooks.postOp)
+            {
+                kernel->compute(op, this);
+                continue;
+            }
+            auto begin = std::chrono::steady_clock::now();
             kernel->compute(op, this);
+            auto end = std::chrono::steady_clock::now();
+            if (profiling)
+            {
+                profiler.record(
+                    op, std::chrono::duration<double, std::milli>(end - begin)
+                            .count());
+            }
+            if (hooks.postOp)
+            {
+                hooks.postOp(hooks.ctx, op,
+                             std::chrono::duration_cast<
+                                 std::chrono::nanoseconds>(end - begin)
+                                 .count());
+            }
+        }
+        if (profiling)
+        {
+            profiler.endRun();
+        }
+        if (hooks.graphEnd)
+        {
+            hooks.graphEnd(hooks.ctx,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - runBegin)
+                               .count());
+        }
+    }
+
+    void NativeCpuRuntimeObj::run(const ExecutionPlan &plan) const
+    {
+        std::chrono::steady_clock::time_point runBegin;
+        if (hooks.graphEnd)
+        {
+            runBegin = std::chrono::steady_clock::now();
+        }
+        if (hooks.graphBegin)
+        {
+            hooks.graphBegin(hooks.ctx);
+        }
+        // everything was resolved at compile time; just walk the steps
+        for (auto &step : plan->getSteps())
+        {
+            if (hooks.preOp)
+            {
+                hooks.preOp(hooks.ctx, step.op);
+            }
+            if (!profiling && !hooks.postOp)
+            {
+                dispatch(step, this);
+                continue;
+            }
+            auto begin = std::chrono::steady_clock::now();
+            dispatch(step, this);
+            auto end = std::chrono::steady_clock::now();
+            if (profiling)
+            {
+                profiler.record(
+                    step.op,
+                    std::chrono::duration<double, std::milli>(end - begin)
+                        .count());
+            }
+            if (hooks.postOp)
+            {
+                hooks.postOp(hooks.ctx, step.op,
+                             std::chrono::duration_cast<
+                                 std::chrono::nanoseconds>(end - begin)
+                                 .count());
+            }
+        }
+        if (profiling)
+        {
+            profiler.endRun();
+        }
+        if (hooks.graphEnd)
+        {
+            hooks.graphEnd(hooks.ctx,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - runBegin)
+                               .count());
+        }
+    }
+
+    void NativeCpuRuntimeObj::runParallel(const ExecutionPlan &plan) const
+    {
+        const auto &steps = plan->getSteps();
+        size_t n = steps.size();
+        if (n == 0)
+        {
+            return;
+        }
+
+        std::chrono::steady_clock::time_point runBegin;
+        if (hooks.graphEnd)
+        {
+            runBegin = std::chrono::steady_clock::now();
+        }
+        if (hooks.graphBegin)
+        {
+            hooks.graphBegin(hooks.ctx);
+        }
+
+        // per-step remaining-predecessor counters; a step becomes ready when
+        // its counter hits zero
+        std::vector<std::atomic<int>> remaining(n);
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::vector<int> ready;
+        size_t finished = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            int preds = plan->predecessorCount((int)i);
+            remaining[i].store(preds, std::memory_order_relaxed);
+            if (preds == 0)
+            {
+                ready.push_back((int)i);
+            }
+        }
+
+        auto worker = [&]()
+        {
+            for (;;)
+            {
+                int step;
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait(lock, [&]
+                            { return !ready.empty() || finished == n; });
+                    if (ready.empty())
+                    {
+                        return; // finished == n
+                    }
+                    step = ready.back();
+                    ready.pop_back();
+                }
+
+                // hooks fire from pool threads here, possibly concurrently;
+                // installed callbacks must be thread-safe
+                if (hooks.preOp)
+                {
+                    hooks.preOp(hooks.ctx, steps[step].op);
+                }
+                if (!profiling && !hooks.postOp)
+                {
+                    dispatch(steps[step], this);
+                }
+                else
+                {
+                    auto begin = std::chrono::steady_clock::now();
+                    dispatch(steps[step], this);
+                    auto end = std::chrono::steady_clock::now();
+                    if (profiling)
+                    {
+                        profiler.record(
+                            steps[step].op,
+                            std::chrono::duration<double, std::milli>(
+                                end - begin)
+                                .count());
+                    }
+                    if (hooks.postOp)
+                    {
+                        hooks.postOp(hooks.ctx, steps[step].op,
+                                     std::chrono::duration_cast<
+                                         std::chrono::nanoseconds>(end - begin)
+                                         .count());
+                    }
+                }
+
+                // release successors whose last predecessor just completed
+                int newlyReady = 0;
+                bool allDone;
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    for (const int *s = plan->successorsBegin(step),
+                                   *e = plan->successorsEnd(step);
+                         s != e; ++s)
+                    {
+                        if (remaining[*s].fetch_sub(
+                                1, std::memory_order_acq_rel) == 1)
+                        {
+                            ready.push_back(*s);
+                            ++newlyReady;
+                        }
+                    }
+                    allDone = ++finished == n;
+                }
+                if (allDone || newlyReady > 1)
+                {
+                    cv.notify_all();
+                }
+                else if (newlyReady == 1)
+                {
+                    cv.notify_one();
+                }
+            }
+        };
+
+        // one long-lived task per pool thread; each drains the ready list.
+        // Kernels called from inside see themselves in a parallel region and
+        // run their loops inline, so cores are not oversubscribed.
+        size_t nWorkers = std::max(1, getWorkers().numThreads());
+        parallelFor(nWorkers, 1, [&](size_t, size_t)
+                    { worker(); });
+        if (profiling)
+        {
+            profiler.endRun();
+        }
+        if (hooks.graphEnd)
+        {
+            hooks.graphEnd(hooks.ctx,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - runBegin)
+                               .count());
         }
     }
 
@@ -29,8 +277,51 @@ namespace infini
 
     void *NativeCpuRuntimeObj::alloc(size_t size)
     {
-        return calloc((size + sizeof(uint64_t) - 1) / sizeof(uint64_t),
-                      sizeof(uint64_t));
+        size_t words = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        if (allocMode == AllocMode::Zeroed)
+        {
+            return calloc(words, sizeof(uint64_t));
+        }
+
+        size_t bytes = words * sizeof(uint64_t);
+        void *ptr = malloc(bytes);
+        if (ptr == nullptr || allocMode == AllocMode::Untouched)
+        {
+            return ptr;
+        }
+
+        char *base = static_cast<char *>(ptr);
+        constexpr size_t pageSize = 4096;
+        size_t nPages = (bytes + pageSize - 1) / pageSize;
+        if (allocMode == AllocMode::FirstTouch)
+        {
+            // the same contiguous partitioning parallelFor hands to the
+            // kernels, so each page is committed on the core that will
+            // stream it
+            parallelFor(nPages, 1, [&](size_t begin, size_t end) {
+                size_t lo = begin * pageSize;
+                size_t hi = std::min(end * pageSize, bytes);
+                memset(base + lo, 0, hi - lo);
+            });
+        }
+        else // AllocMode::Interleaved
+        {
+            // round-robin pages over the workers to spread the arena
+            // across memory controllers
+            size_t nWorkers = std::max(1, workers.numThreads());
+            parallelFor(nWorkers, 1, [&](size_t begin, size_t end) {
+                for (size_t w = begin; w < end; ++w)
+                {
+                    for (size_t p = w; p < nPages; p += nWorkers)
+                    {
+                        size_t lo = p * pageSize;
+                        memset(base + lo, 0,
+                               std::min(pageSize, bytes - lo));
+                    }
+                }
+            });
+        }
+        return ptr;
     }
 
 } // namespace infini
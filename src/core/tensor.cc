@@ -4,6 +4,12 @@
 #include "core/runtime.h"
 #include <cstring>
 #include <numeric>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace infini {
 
@@ -44,6 +50,64 @@ namespace infini {
         return ret;
     }
 
+static Shape denseStrides(const Shape &shape) {
+    Shape strides(shape.size());
+    ShapeElem p = 1;
+    for (auto i = shape.size(); i > 0; --i) {
+        strides[i - 1] = p;
+        p = p * shape[i - 1];
+    }
+    return strides;
+}
+
+Shape TensorObj::getStrides() const {
+    return strides.empty() ? denseStrides(shape) : strides;
+}
+
+bool TensorObj::isContiguous() const {
+    return strides.empty() || strides == denseStrides(shape);
+}
+
+Tensor TensorObj::makeView(const Tensor &t, Shape shape, Shape strides,
+                           size_t offset) {
+    // collapse chains so a view always references real storage directly
+    auto storage = t->viewStorage ? t->viewStorage : t;
+    auto view = make_ref<TensorObj>(std::move(shape), t->dtype, t->runtime);
+    view->strides = std::move(strides);
+    view->viewOffset = offset;
+    view->viewStorage = storage;
+    // storage already bound (e.g. a graph after dataMalloc): alias it now;
+    // otherwise dataMalloc binds the view along with its storage root
+    if (storage->hasData()) {
+        view->data = storage->data;
+    }
+    return view;
+}
+
+Tensor TensorObj::slice(const Tensor &t, int dim, int begin, int end) {
+    IT_ASSERT(dim >= 0 && (size_t)dim < t->getRank());
+    IT_ASSERT(begin >= 0 && begin < end && end <= t->shape[dim]);
+    auto strides = t->getStrides();
+    Shape shape = t->shape;
+    shape[dim] = end - begin;
+    size_t offset = t->viewOffset + (size_t)begin * strides[dim];
+    return makeView(t, std::move(shape), std::move(strides), offset);
+}
+
+Tensor TensorObj::narrow(const Tensor &t, int dim, int start, int length) {
+    return slice(t, dim, start, start + length);
+}
+
+Tensor TensorObj::squeeze(const Tensor &t, int dim) {
+    IT_ASSERT(dim >= 0 && (size_t)dim < t->getRank());
+    IT_ASSERT(t->shape[dim] == 1, "only size-1 dims can be squeezed");
+    auto strides = t->getStrides();
+    Shape shape = t->shape;
+    shape.erase(shape.begin() + dim);
+    strides.erase(strides.begin() + dim);
+    return makeView(t, std::move(shape), std::move(strides), t->viewOffset);
+}
+
 void TensorObj::setShape(Shape shape_) {
     shape = shape_;
     size_t size = std::accumulate(shape.begin(), shape.end(), 1,
@@ -83,6 +147,8 @@ void TensorObj::printData() const {
 bool TensorObj::equalData(const Tensor &rhs, double relativeError) const {
     IT_ASSERT(data != nullptr);
     IT_ASSERT(rhs->data != nullptr);
+    // linear scans below; strided views would need per-index mapping
+    IT_ASSERT(isContiguous() && rhs->isContiguous());
     IT_ASSERT(getDType() == rhs->getDType());
     IT_ASSERT(runtime->isCpu());
     IT_ASSERT(rhs->getRuntime()->isCpu());
@@ -115,12 +181,152 @@ bool TensorObj::equalData(const Tensor &rhs, double relativeError) const {
 #undef TEST_EQUAL
 }
 
+CompareStats TensorObj::compareData(const Tensor &rhs,
+                                    double relativeError) const {
+    IT_ASSERT(data != nullptr);
+    IT_ASSERT(rhs->data != nullptr);
+    IT_ASSERT(getDType() == rhs->getDType());
+    IT_ASSERT(runtime->isCpu());
+    IT_ASSERT(rhs->getRuntime()->isCpu());
+    IT_ASSERT(size() == rhs->size());
+    IT_ASSERT(isContiguous() && rhs->isContiguous());
+
+#define TEST_COMPARE(N)                                                        \
+    if (dtype == DataType(N))                                                  \
+        return compareDataImpl(getRawDataPtr<DT<N>::t *>(),                    \
+                               rhs->getRawDataPtr<DT<N>::t *>(), size(),       \
+                               relativeError);
+
+    TEST_COMPARE(0)           // fmt: new line
+    else TEST_COMPARE(1)      //
+        else TEST_COMPARE(2)  //
+        else TEST_COMPARE(3)  //
+        else TEST_COMPARE(4)  //
+        else TEST_COMPARE(5)  //
+        else TEST_COMPARE(6)  //
+        else TEST_COMPARE(7)  //
+        else TEST_COMPARE(8)  //
+        else TEST_COMPARE(9)  //
+        else TEST_COMPARE(10) //
+        else TEST_COMPARE(11) //
+        else TEST_COMPARE(12) //
+        else TEST_COMPARE(13) //
+        else TEST_COMPARE(16) //
+        else IT_TODO_HALT();
+
+#undef TEST_COMPARE
+}
+
+// binary dump layout: the header below, then `rank` int32 dims, then the
+// raw buffer. Everything is host-endian; these files are debugging
+// captures, not an interchange format.
+namespace {
+struct TensorDumpHeader {
+    char magic[4]; // "ITSR"
+    uint32_t version;
+    int32_t dtypeIndex;
+    int32_t fuid;
+    uint32_t rank;
+};
+} // namespace
+
+void TensorObj::dumpTo(const string &path) const {
+    IT_ASSERT(data != nullptr);
+    IT_ASSERT(isContiguous(), "dump a materialized copy, not a strided view");
+    std::ofstream out(path, std::ios::binary);
+    IT_ASSERT(out.good(), "cannot open " + path + " for writing");
+
+    TensorDumpHeader header{{'I', 'T', 'S', 'R'},
+                            1,
+                            dtype.getIndex(),
+                            (int32_t)(UidBaseType)fuid,
+                            (uint32_t)shape.size()};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    vector<int32_t> dims(shape.begin(), shape.end());
+    out.write(reinterpret_cast<const char *>(dims.data()),
+              dims.size() * sizeof(int32_t));
+    // the payload goes out in one direct write; no per-element formatting
+    out.write(getRawDataPtr<const char *>(), getBytes());
+    IT_ASSERT(out.good(), "failed writing " + path);
+}
+
+void TensorObj::loadFrom(const string &path) {
+    IT_ASSERT(isContiguous(), "load into the storage tensor, not a view");
+    size_t headerBytes;
+    auto checkHeader = [&](const char *bytes, size_t fileBytes) {
+        IT_ASSERT(fileBytes >= sizeof(TensorDumpHeader));
+        TensorDumpHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        IT_ASSERT(std::memcmp(header.magic, "ITSR", 4) == 0 &&
+                      header.version == 1,
+                  path + " is not a tensor dump");
+        IT_ASSERT(header.dtypeIndex == dtype.getIndex(),
+                  "dtype mismatch loading " + path);
+        IT_ASSERT(header.rank == shape.size(),
+                  "rank mismatch loading " + path);
+        vector<int32_t> dims(header.rank);
+        std::memcpy(dims.data(), bytes + sizeof(header),
+                    header.rank * sizeof(int32_t));
+        for (size_t i = 0; i < shape.size(); ++i) {
+            IT_ASSERT(dims[i] == shape[i], "shape mismatch loading " + path);
+        }
+        headerBytes = sizeof(header) + header.rank * sizeof(int32_t);
+        IT_ASSERT(fileBytes == headerBytes + getBytes(),
+                  "payload size mismatch loading " + path);
+    };
+
+    if (data == nullptr) {
+        setDataBlob(make_ref<BlobObj>(runtime, runtime->alloc(getBytes())));
+    }
+
+#ifdef __linux__
+    int fd = open(path.c_str(), O_RDONLY);
+    IT_ASSERT(fd >= 0, "cannot open " + path);
+    struct stat st;
+    IT_ASSERT(fstat(fd, &st) == 0);
+    void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    IT_ASSERT(mapped != MAP_FAILED, "cannot map " + path);
+    const char *bytes = static_cast<const char *>(mapped);
+    checkHeader(bytes, (size_t)st.st_size);
+    std::memcpy(getRawDataPtr<void *>(), bytes + headerBytes, getBytes());
+    munmap(mapped, st.st_size);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    IT_ASSERT(in.good(), "cannot open " + path);
+    size_t fileBytes = (size_t)in.tellg();
+    in.seekg(0);
+    vector<char> head(std::min(fileBytes, (size_t)4096));
+    in.read(head.data(), head.size());
+    checkHeader(head.data(), fileBytes);
+    in.seekg(headerBytes);
+    in.read(getRawDataPtr<char *>(), getBytes());
+    IT_ASSERT(in.good(), "failed reading " + path);
+#endif
+    ++dataVersion;
+}
+
 void TensorObj::setData(
     const std::function<void(void *, size_t, DataType)> &generator) const {
     IT_ASSERT(data != nullptr);
+    IT_ASSERT(isContiguous(), "generate into the storage tensor, not a view");
     generator(getRawDataPtr<void *>(), size(), dtype);
+    ++dataVersion;
 }
 
-void TensorObj::setDataBlob(const Blob &blob) { this->data = blob; }
+void TensorObj::setDataBlob(const Blob &blob) {
+    this->data = blob;
+    ++dataVersion;
+}
+
+void TensorObj::setData(void *buffer, size_t bytes) {
+    IT_ASSERT(!isView(), "bind buffers to the storage tensor, not a view");
+    IT_ASSERT(bytes == getBytes(),
+              "adopted buffer size does not match the tensor");
+    // blobs do not own their pointer, so this neither copies the bytes nor
+    // frees them later — the caller keeps ownership
+    this->data = make_ref<BlobObj>(runtime, buffer);
+    ++dataVersion;
+}
 
 }; // namespace infini
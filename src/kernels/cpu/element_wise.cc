@@ -1,114 +1,238 @@
 #include "operators/element_wise.h"
 #include "core/kernel.h"
+#include "utils/half.h"
 #include "utils/operator_utils.h"
+#include <limits>
 
 namespace infini
 {
+    // Minimum elements per worker task; below this the dispatch overhead
+    // outweighs the span of a streaming op.
+    static constexpr size_t PARALLEL_GRAIN = 1 << 15;
+
+    template <typename T>
+    static T addCompute(T val0, T val1)
+    {
+        return val0 + val1;
+    }
+
+    template <typename T>
+    static T subCompute(T val0, T val1)
+    {
+        return val0 - val1;
+    }
+
+    template <typename T>
+    static T mulCompute(T val0, T val1)
+    {
+        return val0 * val1;
+    }
+
+    template <typename T>
+    static T divCompute(T val0, T val1)
+    {
+        return (T)(val0 / val1);
+    }
+
+    // Shared launch path for the plain and fused elementwise kernels, built
+    // on BroadcastIterator: runs are distributed over the worker pool and
+    // the inner loop is specialized on whether each input advances (stride
+    // 1) or is broadcast (stride 0), so every case inlines Fn and
+    // vectorizes. When Clamp is set the result is clamped to [lo, hi],
+    // which expresses both Relu and Clip activations branchlessly.
+    template <typename T, T (*Fn)(T, T), bool Clamp>
+    static void launchBinary(const Operator &_op, const RuntimeObj *context,
+                             T lo = T(0), T hi = T(0))
+    {
+        T *in0 = _op->getInputs(0)->getRawDataPtr<T *>();
+        T *in1 = _op->getInputs(1)->getRawDataPtr<T *>();
+        T *out = _op->getOutput()->getRawDataPtr<T *>();
+
+        BroadcastIterator it(_op->getInputs(0)->getDims(),
+                             _op->getInputs(0)->getStrides(),
+                             _op->getInputs(1)->getDims(),
+                             _op->getInputs(1)->getStrides(),
+                             _op->getOutput()->getDims());
+        size_t inner = it.innerExtent();
+        int sA = it.innerStrideA(), sB = it.innerStrideB();
+        auto apply = [lo, hi](T v)
+        {
+            if constexpr (Clamp)
+                return std::min(hi, std::max(lo, v));
+            else
+                return v;
+        };
+        auto cpuRuntime = static_cast<const NativeCpuRuntimeObj *>(context);
+        size_t grain = std::max<size_t>(1, PARALLEL_GRAIN / inner);
+        cpuRuntime->parallelFor(
+            it.numRuns(), grain,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t r = begin; r < end; ++r)
+                {
+                    size_t offA, offB;
+                    it.locate(r, offA, offB);
+                    T *dst = out + r * inner;
+                    const T *a = in0 + offA, *b = in1 + offB;
+                    if (sA == 1 && sB == 1)
+                    {
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = apply(Fn(a[j], b[j]));
+                    }
+                    else if (sA == 1 && sB == 0)
+                    {
+                        T bv = *b;
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = apply(Fn(a[j], bv));
+                    }
+                    else if (sA == 0 && sB == 1)
+                    {
+                        T av = *a;
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = apply(Fn(av, b[j]));
+                    }
+                    else if (sA == 0 && sB == 0)
+                    {
+                        T v = apply(Fn(*a, *b));
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = v;
+                    }
+                    else
+                    {
+                        // strided view input(s): gather loads, still one pass
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = apply(Fn(a[j * (size_t)sA],
+                                              b[j * (size_t)sB]));
+                    }
+                }
+            });
+    }
+
     class NativeElementWise : public CpuKernelWithoutConfig
     {
-        template <typename T>
-        static T addCompute(T val0, T val1)
+        // one fully specialized entry point per (dtype, optype) pair; the
+        // compiled plan stores a pointer to one of these, so a run is a
+        // single indirect call into a body whose Fn is inlined
+        template <typename T, T (*Fn)(T, T)>
+        static void doCompute(const Operator &_op, const RuntimeObj *context)
         {
-            return val0 + val1;
+            launchBinary<T, Fn, false>(_op, context);
         }
 
         template <typename T>
-        static T subCompute(T val0, T val1)
+        static SpecializedCompute pickOp(const Operator &_op)
         {
-            return val0 - val1;
+            switch (_op->getOpType().underlying())
+            {
+            case OpType::Add:
+                return doCompute<T, addCompute<T>>;
+            case OpType::Sub:
+                return doCompute<T, subCompute<T>>;
+            case OpType::Mul:
+                return doCompute<T, mulCompute<T>>;
+            case OpType::Div:
+                return doCompute<T, divCompute<T>>;
+            default:
+                IT_TODO_HALT();
+            }
+            return nullptr;
         }
 
-        template <typename T>
-        static T mulCompute(T val0, T val1)
+        SpecializedCompute specialize(const Operator &_op) const override
+        {
+#define CASE(N) \
+    case N:     \
+        return pickOp<DT<N>::t>(_op)
+
+            switch (_op->getDType().getIndex())
+            {
+                CASE(1);  // DataType::Float32
+                CASE(12); // DataType::UInt32
+            // half-precision storage: the wrappers load 16-bit, compute
+            // in fp32 and store 16-bit
+            case 10: // DataType::Float16
+                return pickOp<fp16_t>(_op);
+            case 16: // DataType::BFloat16
+                return pickOp<bf16_t>(_op);
+            default:
+                IT_TODO_HALT();
+            }
+            return nullptr;
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
         {
-            return val0 * val1;
+            // the un-compiled path resolves the same specialization per call
+            specialize(_op)(_op, context);
         }
+    };
 
-        template <typename T>
-        static T divCompute(T val0, T val1)
+    // Fused elementwise+activation: the arithmetic op and the activation
+    // clamp run in one pass over the data.
+    class NativeFusedElemAct : public CpuKernelWithoutConfig
+    {
+        // the clamp bounds are op state, not specialization state: they
+        // are re-read per call so a rebound/cloned op stays correct
+        template <typename T, T (*Fn)(T, T)>
+        static void doCompute(const Operator &_op, const RuntimeObj *context)
         {
-            return (T)(val0 / val1);
+            auto op = as<FusedElemActObj>(_op);
+            T lo, hi;
+            if (op->getActType() == OpType::Relu)
+            {
+                lo = T(0);
+                hi = std::numeric_limits<T>::max();
+            }
+            else
+            {
+                lo = op->getMin() ? (T)*op->getMin()
+                                  : std::numeric_limits<T>::lowest();
+                hi = op->getMax() ? (T)*op->getMax()
+                                  : std::numeric_limits<T>::max();
+            }
+            launchBinary<T, Fn, true>(_op, context, lo, hi);
         }
 
         template <typename T>
-        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        static SpecializedCompute pickOp(const Operator &_op)
         {
-            auto op = as<ElementWiseObj>(_op);
-            T *inptr0 = op->getInputs(0)->getRawDataPtr<T *>();
-            T *inptr1 = op->getInputs(1)->getRawDataPtr<T *>();
-            T *outptr = op->getOutput()->getRawDataPtr<T *>();
-
-            auto shapeA = op->getInputs(0)->getDims();
-            auto shapeB = op->getInputs(1)->getDims();
-            auto shapeC = op->getOutput()->getDims();
-            auto rank = op->getOutput()->getRank();
-            Shape a(rank, 1);
-            Shape b(rank, 1);
-            std::copy(shapeA.begin(), shapeA.end(),
-                      a.begin() + (rank - shapeA.size()));
-            std::copy(shapeB.begin(), shapeB.end(),
-                      b.begin() + (rank - shapeB.size()));
-            auto getStride = [&](const Shape &shape)
-            {
-                int p = 1;
-                Shape stride(rank);
-                for (auto i = rank; i > 0; --i)
-                {
-                    stride[i - 1] = p;
-                    p = p * shape[i - 1];
-                }
-                return stride;
-            };
-            Shape strideA = getStride(a);
-            Shape strideB = getStride(b);
-
-            auto n = op->getOutput()->size();
-            T (*_doCompute)
-            (T val0, T val1);
-            switch (op->getOpType().underlying())
+            switch (as<FusedElemActObj>(_op)->getElemType().underlying())
             {
             case OpType::Add:
-                _doCompute = addCompute<T>;
-                break;
+                return doCompute<T, addCompute<T>>;
             case OpType::Sub:
-                _doCompute = subCompute<T>;
-                break;
+                return doCompute<T, subCompute<T>>;
             case OpType::Mul:
-                _doCompute = mulCompute<T>;
-                break;
+                return doCompute<T, mulCompute<T>>;
             case OpType::Div:
-                _doCompute = divCompute<T>;
-                break;
+                return doCompute<T, divCompute<T>>;
             default:
                 IT_TODO_HALT();
             }
-
-            for (size_t i = 0; i < n; ++i)
-            {
-                auto shapeIndexC = locate_index(i, shapeC);
-                auto indexA = delocate_index(shapeIndexC, a, strideA);
-                auto indexB = delocate_index(shapeIndexC, b, strideB);
-                outptr[i] = _doCompute(inptr0[indexA], inptr1[indexB]);
-            }
+            return nullptr;
         }
 
-        void compute(const Operator &_op,
-                     const RuntimeObj *context) const override
+        SpecializedCompute specialize(const Operator &_op) const override
         {
-#define CASE(N) \
-    case N:     \
-        doCompute<DT<N>::t>(_op, context)
-
-            int dataTypeIdx = _op->getDType().getIndex();
-            switch (dataTypeIdx)
+            switch (_op->getDType().getIndex())
             {
-                CASE(1); // DataType::Float32
-                break;
+                CASE(1);  // DataType::Float32
                 CASE(12); // DataType::UInt32
-                break;
+            case 10: // DataType::Float16
+                return pickOp<fp16_t>(_op);
+            case 16: // DataType::BFloat16
+                return pickOp<bf16_t>(_op);
             default:
                 IT_TODO_HALT();
             }
+            return nullptr;
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            specialize(_op)(_op, context);
         }
     };
 
@@ -116,4 +240,6 @@ namespace infini
     REGISTER_KERNEL(Device::CPU, OpType::Sub, NativeElementWise, "subNaive_CPU");
     REGISTER_KERNEL(Device::CPU, OpType::Mul, NativeElementWise, "mulNaive_CPU");
     REGISTER_KERNEL(Device::CPU, OpType::Div, NativeElementWise, "divNaive_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::FusedElemAct, NativeFusedElemAct,
+                    "fusedElemAct_CPU");
 }; // namespace infini
@@ -0,0 +1,99 @@
+#include "operators/quantize.h"
+#include "core/kernel.h"
+#include "utils/operator_utils.h"
+#include <cmath>
+
+namespace infini
+{
+    // Minimum elements per worker task for the streaming quantize loops.
+    static constexpr size_t PARALLEL_GRAIN = 1 << 15;
+
+    // Run-wise launch shared by both kernels, so strided view inputs work
+    // like they do for the unary kernels; the dense case is one linear run.
+    template <typename Src, typename Dst, typename Fn>
+    static void launchMap(const Operator &_op, const RuntimeObj *context,
+                          Fn fn)
+    {
+        Src *inptr = _op->getInputs(0)->getRawDataPtr<Src *>();
+        Dst *outptr = _op->getOutput()->getRawDataPtr<Dst *>();
+
+        RunIterator it(_op->getInputs(0)->getDims(),
+                       _op->getInputs(0)->getStrides());
+        size_t inner = it.innerExtent();
+        int stride = it.innerStride();
+        auto cpuRuntime = static_cast<const NativeCpuRuntimeObj *>(context);
+        size_t grain = std::max<size_t>(1, PARALLEL_GRAIN / inner);
+        cpuRuntime->parallelFor(
+            it.numRuns(), grain,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t r = begin; r < end; ++r)
+                {
+                    const Src *src = inptr + it.locate(r);
+                    Dst *dst = outptr + r * inner;
+                    for (size_t j = 0; j < inner; ++j)
+                        dst[j] = fn(src[j * (size_t)stride]);
+                }
+            });
+    }
+
+    class NativeQuantizeLinear : public CpuKernelWithoutConfig
+    {
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            auto op = as<QuantizeLinearObj>(_op);
+            // Hoist the reciprocal so the loop body is a multiply, a round
+            // and two min/max, all of which vectorize.
+            float invScale = 1.0f / op->getScale();
+            int zp = op->getZeroPoint();
+            launchMap<float, int8_t>(
+                _op, context,
+                [invScale, zp](float v)
+                {
+                    int q = (int)std::lrintf(v * invScale) + zp;
+                    return (int8_t)std::min(127, std::max(-128, q));
+                });
+        }
+    };
+
+    class NativeDequantizeLinear : public CpuKernelWithoutConfig
+    {
+        template <typename T>
+        static void doCompute(const Operator &_op, const RuntimeObj *context)
+        {
+            auto op = as<DequantizeLinearObj>(_op);
+            float scale = op->getScale();
+            int zp = op->getZeroPoint();
+            launchMap<T, float>(_op, context, [scale, zp](T v)
+                                { return (float)((int)v - zp) * scale; });
+        }
+
+        SpecializedCompute specialize(const Operator &_op) const override
+        {
+#define CASE(N) \
+    case N:     \
+        return doCompute<DT<N>::t>
+
+            switch (_op->getDType().getIndex())
+            {
+                CASE(3); // DataType::Int8
+                CASE(6); // DataType::Int32, the int8 MatMul accumulator
+            default:
+                IT_TODO_HALT();
+            }
+            return nullptr;
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            specialize(_op)(_op, context);
+        }
+    };
+
+    REGISTER_KERNEL(Device::CPU, OpType::QuantizeLinear, NativeQuantizeLinear,
+                    "quantizeLinear_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::DequantizeLinear,
+                    NativeDequantizeLinear, "dequantizeLinear_CPU");
+}; // namespace infini
@@ -0,0 +1,61 @@
+#include "core/kernel.h"
+#include "utils/operator_utils.h"
+#include <cstring>
+
+namespace infini
+{
+    // Reshape/Flatten/Identity never rearrange bytes. dataMalloc aliases the
+    // output onto the input's storage, which makes these ops free at run
+    // time; the copy below only fires when the two tensors were bound to
+    // separate buffers (e.g. the scratch outputs used by constant folding,
+    // or a non-contiguous view input, which cannot alias — so Identity on
+    // a view doubles as its materialization).
+    class NaiveAliasCopy : public CpuKernelWithoutConfig
+    {
+        void compute(const Operator &op,
+                     const RuntimeObj *context) const override
+        {
+            auto input = op->getInputs(0), output = op->getOutput();
+            const char *src = input->getRawDataPtr<const char *>();
+            char *dst = output->getRawDataPtr<char *>();
+            if (src == dst)
+            {
+                return;
+            }
+            if (input->isContiguous())
+            {
+                std::memcpy(dst, src, input->getBytes());
+                return;
+            }
+            // strided view input: copy run by run into the dense output
+            RunIterator it(input->getDims(), input->getStrides());
+            size_t elemBytes = input->getDType().getSize();
+            size_t inner = it.innerExtent();
+            size_t stride = (size_t)it.innerStride();
+            for (size_t r = 0; r < it.numRuns(); ++r)
+            {
+                const char *from = src + it.locate(r) * elemBytes;
+                char *to = dst + r * inner * elemBytes;
+                if (stride == 1)
+                {
+                    std::memcpy(to, from, inner * elemBytes);
+                }
+                else
+                {
+                    for (size_t j = 0; j < inner; ++j)
+                    {
+                        std::memcpy(to + j * elemBytes,
+                                    from + j * stride * elemBytes, elemBytes);
+                    }
+                }
+            }
+        }
+    };
+
+    REGISTER_KERNEL(Device::CPU, OpType::Reshape, NaiveAliasCopy,
+                    "reshape_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::Flatten, NaiveAliasCopy,
+                    "flatten_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::Identity, NaiveAliasCopy,
+                    "identity_CPU");
+} // namespace infini
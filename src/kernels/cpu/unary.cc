@@ -1,105 +1,194 @@
 #include "operators/unary.h"
 #include "core/kernel.h"
+#include "utils/half.h"
+#include "utils/operator_utils.h"
+#include <limits>
 
 namespace infini
 {
-    class NativeUnary : public CpuKernelWithoutConfig
+    // Minimum elements per worker task for the streaming unary loops.
+    static constexpr size_t PARALLEL_GRAIN = 1 << 15;
+
+    // Shared launch path for the streaming unary kernels: the dense input
+    // case is one run with stride 1 and keeps the old linear loop; strided
+    // view inputs decompose into runs via RunIterator, with a gather loop
+    // when even the innermost dim is not unit-stride.
+    template <typename Src, typename Dst, typename Fn>
+    static void launchMap(const Operator &_op, const RuntimeObj *context,
+                          Fn fn)
+    {
+        Src *inptr = _op->getInputs(0)->getRawDataPtr<Src *>();
+        Dst *outptr = _op->getOutput()->getRawDataPtr<Dst *>();
+
+        RunIterator it(_op->getInputs(0)->getDims(),
+                       _op->getInputs(0)->getStrides());
+        size_t inner = it.innerExtent();
+        int stride = it.innerStride();
+        auto cpuRuntime = static_cast<const NativeCpuRuntimeObj *>(context);
+        size_t grain = std::max<size_t>(1, PARALLEL_GRAIN / inner);
+        cpuRuntime->parallelFor(
+            it.numRuns(), grain,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t r = begin; r < end; ++r)
+                {
+                    const Src *src = inptr + it.locate(r);
+                    Dst *dst = outptr + r * inner;
+                    if (stride == 1)
+                    {
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = fn(src[j]);
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < inner; ++j)
+                            dst[j] = fn(src[j * (size_t)stride]);
+                    }
+                }
+            });
+    }
+
+    // These ops are pure streaming passes; the per-element lambdas inline
+    // into launchMap's loops, so min/max still compile to vector min/max
+    // instructions and the dense case runs at memory bandwidth.
+    class NativeRelu : public CpuKernelWithoutConfig
     {
+        // static per-dtype instantiations so compile() can bake a direct
+        // pointer to the specialized body into the plan
         template <typename T>
-        static T reluCompute(T val)
+        static void doCompute(const Operator &_op, const RuntimeObj *context)
         {
-            return std::max(T(0), val);
+            launchMap<T, T>(_op, context,
+                            [](T v) { return std::max(T(0), v); });
         }
 
-        template <typename T>
-        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        SpecializedCompute specialize(const Operator &_op) const override
         {
-            auto op = as<UnaryObj>(_op);
-            T *inptr = op->getInputs(0)->getRawDataPtr<T *>();
-            T *outptr = op->getOutput()->getRawDataPtr<T *>();
-
-            auto outDim = op->getOutput()->getDims();
-            auto n = op->getOutput()->size();
+#define CASE(N) \
+    case N:     \
+        return doCompute<DT<N>::t>
 
-            T (*_doCompute)
-            (T val);
-            switch (op->getOpType().underlying())
+            switch (_op->getDType().getIndex())
             {
-            case OpType::Relu:
-                _doCompute = reluCompute<T>;
-                break;
+                CASE(1);  // DataType::Float32
+                CASE(12); // DataType::UInt32
+            case 10: // DataType::Float16
+                return doCompute<fp16_t>;
+            case 16: // DataType::BFloat16
+                return doCompute<bf16_t>;
             default:
                 IT_TODO_HALT();
             }
-
-            for (size_t offset = 0; offset < n; offset++)
-            {
-                outptr[offset] = _doCompute(inptr[offset]);
-            }
+            return nullptr;
         }
 
         void compute(const Operator &_op,
                      const RuntimeObj *context) const override
         {
-#define CASE(N) \
-    case N:     \
-        doCompute<DT<N>::t>(_op, context)
-
-            int dataTypeIdx = _op->getDType().getIndex();
-            switch (dataTypeIdx)
-            {
-                CASE(1); // DataType::Float32
-                break;
-                CASE(12); // DataType::UInt32
-                break;
-            default:
-                IT_TODO_HALT();
-            }
+            specialize(_op)(_op, context);
         }
     };
 
     class Clip : public CpuKernelWithoutConfig
     {
         template <typename T>
-        void doCompute(const Operator &_op, const RuntimeObj *context) const
+        static void doCompute(const Operator &_op, const RuntimeObj *context)
         {
             auto op = as<ClipObj>(_op);
-            T *inptr = op->getInputs(0)->getRawDataPtr<T *>();
-            T *outptr = op->getOutput()->getRawDataPtr<T *>();
-            auto minValue = op->getMin();
-            auto maxValue = op->getMax();
+            // Resolve the optional bounds once; absent bounds become the type
+            // limits so the loop body is an unconditional clamp.
+            T lo = op->getMin() ? (T)*op->getMin()
+                                : std::numeric_limits<T>::lowest();
+            T hi = op->getMax() ? (T)*op->getMax()
+                                : std::numeric_limits<T>::max();
+            launchMap<T, T>(_op, context, [lo, hi](T v)
+                            { return std::min(hi, std::max(lo, v)); });
+        }
 
-            auto n = op->getOutput()->size();
-            for (size_t offset = 0; offset < n; offset++)
+        SpecializedCompute specialize(const Operator &_op) const override
+        {
+            switch (_op->getDType().getIndex())
             {
-                auto val = *inptr++;
-                *outptr++ = (minValue && val < *minValue)   ? *minValue
-                            : (maxValue && val > *maxValue) ? *maxValue
-                                                            : val;
+                CASE(1);  // DataType::Float32
+                CASE(12); // DataType::UInt32
+            case 10: // DataType::Float16
+                return doCompute<fp16_t>;
+            case 16: // DataType::BFloat16
+                return doCompute<bf16_t>;
+            default:
+                IT_TODO_HALT();
             }
+            return nullptr;
         }
 
         void compute(const Operator &_op,
                      const RuntimeObj *context) const override
         {
-#define CASE(N) \
-    case N:     \
-        doCompute<DT<N>::t>(_op, context)
+            specialize(_op)(_op, context);
+        }
+    };
 
-            int dataTypeIdx = _op->getDType().getIndex();
-            switch (dataTypeIdx)
+    class Cast : public CpuKernelWithoutConfig
+    {
+        template <typename Src, typename Dst>
+        static void doCast(const Operator &_op, const RuntimeObj *context)
+        {
+            launchMap<Src, Dst>(_op, context, [](Src v)
+                                { return static_cast<Dst>(v); });
+        }
+
+        SpecializedCompute specialize(const Operator &_op) const override
+        {
+            // The source/destination types are resolved once; the
+            // per-element work is a plain converting copy that vectorizes.
+#define CAST_CASE(E, S, D) \
+    case CastType::E:      \
+        return doCast<S, D>
+
+            switch (as<CastObj>(_op)->getType())
             {
-                CASE(1); // DataType::Float32
-                break;
-                CASE(12); // DataType::UInt32
-                break;
+                CAST_CASE(Float2Int64, float, int64_t);
+                CAST_CASE(Float2Int32, float, int32_t);
+                CAST_CASE(Float2Int16, float, int16_t);
+                CAST_CASE(Float2Int8, float, int8_t);
+                CAST_CASE(Int322Float, int32_t, float);
+                CAST_CASE(Int322Int8, int32_t, int8_t);
+                CAST_CASE(Int322Int16, int32_t, int16_t);
+                CAST_CASE(Int322Int64, int32_t, int64_t);
+                CAST_CASE(Int162Float, int16_t, float);
+                CAST_CASE(Int162Int32, int16_t, int32_t);
+                CAST_CASE(Int82Float, int8_t, float);
+                CAST_CASE(Int82Int16, int8_t, int16_t);
+                CAST_CASE(Int82Int32, int8_t, int32_t);
+                CAST_CASE(Uint82Float, uint8_t, float);
+                CAST_CASE(Uint82Int32, uint8_t, int32_t);
+                CAST_CASE(Uint82Int64, uint8_t, int64_t);
+                CAST_CASE(Int642Int32, int64_t, int32_t);
+                CAST_CASE(Int642Uint32, int64_t, uint32_t);
+                CAST_CASE(Int642Float, int64_t, float);
+                CAST_CASE(Uint322Int64, uint32_t, int64_t);
+                CAST_CASE(Float2Float, float, float);
+                // half-precision: the wrapper types convert at load/store
+                CAST_CASE(Float2Float16, float, fp16_t);
+                CAST_CASE(Float162Float, fp16_t, float);
+                CAST_CASE(Float2BFloat16, float, bf16_t);
+                CAST_CASE(BFloat162Float, bf16_t, float);
+#undef CAST_CASE
             default:
                 IT_TODO_HALT();
             }
+            return nullptr;
+        }
+
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            specialize(_op)(_op, context);
         }
     };
 
-    REGISTER_KERNEL(Device::CPU, OpType::Relu, NativeUnary, "reluNaive_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::Relu, NativeRelu, "reluNaive_CPU");
     REGISTER_KERNEL(Device::CPU, OpType::Clip, Clip, "Clip_CPU");
+    REGISTER_KERNEL(Device::CPU, OpType::Cast, Cast, "Cast_CPU");
 
 }; // namespace infini
@@ -1,5 +1,6 @@
 #include "operators/element_wise.h"
 #include "utils/operator_utils.h"
+#include <cstring>
 
 namespace infini
 {
@@ -30,4 +31,56 @@ namespace infini
         return os.str();
     }
 
+    FusedElemActObj::FusedElemActObj(GraphObj *graph, OpType elemType,
+                                     OpType actType, Tensor input0,
+                                     Tensor input1, Tensor output,
+                                     std::optional<float> min,
+                                     std::optional<float> max)
+        : OperatorObj(OpType::FusedElemAct, {input0, input1}, {output}),
+          elemType(elemType), actType(actType), minValue(min), maxValue(max)
+    {
+        IT_ASSERT(elemType == OpType::Add || elemType == OpType::Sub ||
+                  elemType == OpType::Mul || elemType == OpType::Div);
+        IT_ASSERT(actType == OpType::Relu || actType == OpType::Clip);
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> FusedElemActObj::inferShape(const TensorVec &inputs)
+    {
+        const auto A = inputs[0], B = inputs[1];
+        auto res = infer_broadcast(A->getDims(), B->getDims());
+        return {{res}};
+    }
+
+    std::string FusedElemActObj::toString() const
+    {
+        std::ostringstream os;
+        os << elemType.toString() << "+" << actType.toString() << "["
+           << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << vecToString(inputs[1]->getDims()) << ",";
+        os << "input0=" << inputs[0]->getGuid() << ",";
+        os << "input1=" << inputs[1]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    vector<int> FusedElemActObj::getOpAttrVector() const
+    {
+        auto bits = [](const std::optional<float> &v)
+        {
+            if (!v)
+            {
+                return 0;
+            }
+            int b;
+            std::memcpy(&b, &*v, sizeof(b));
+            return b;
+        };
+        return {type.underlying(), elemType.underlying(),
+                actType.underlying(), minValue.has_value(), bits(minValue),
+                maxValue.has_value(), bits(maxValue)};
+    }
+
 }; // namespace infini
@@ -21,6 +21,15 @@ namespace infini
         return os.str();
     }
 
+    vector<DataType> MatmulObj::inferDataType(const TensorVec &inputs) const
+    {
+        if (inputs[0]->getDType() == DataType::Int8)
+        {
+            return {DataType::Int32};
+        }
+        return OperatorObj::inferDataType(inputs);
+    }
+
     optional<vector<Shape>> MatmulObj::inferShape(const TensorVec &inputs)
     {
         const auto A = inputs[0];
@@ -42,7 +51,12 @@ namespace infini
         
         // Check matrix multiplication compatibility
         IT_ASSERT(dimA_k == dimB_k);
-        
+
+        // Record the GEMM dimensions (used by toString and getFlops)
+        m = dimA_m;
+        n = dimB_n;
+        k = dimA_k;
+
         // Handle batch dimensions (all dimensions except last 2)
         Shape batchA(shapeA.begin(), shapeA.end() - 2);
         Shape batchB(shapeB.begin(), shapeB.end() - 2);
@@ -0,0 +1,101 @@
+#include "operators/quantize.h"
+#include <cstring>
+
+namespace infini
+{
+    // getOpAttrVector encodes the scale by bit pattern (like ClipObj's
+    // bounds), so CSE only merges ops with bit-identical scales.
+    static int scaleBits(float scale)
+    {
+        int bits;
+        std::memcpy(&bits, &scale, sizeof(bits));
+        return bits;
+    }
+
+    QuantizeLinearObj::QuantizeLinearObj(GraphObj *graph, Tensor input,
+                                         Tensor output, float scale,
+                                         int zeroPoint)
+        : OperatorObj(OpType::QuantizeLinear, {input}, {output}), scale(scale),
+          zeroPoint(zeroPoint)
+    {
+        IT_ASSERT(scale > 0.0f);
+        IT_ASSERT(input->getDType() == DataType::Float32);
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> QuantizeLinearObj::inferShape(
+        const TensorVec &inputs)
+    {
+        const auto A = inputs[0];
+        return {{A->getDims()}};
+    }
+
+    vector<DataType> QuantizeLinearObj::inferDataType(
+        const TensorVec &inputs) const
+    {
+        return {DataType::Int8};
+    }
+
+    std::string QuantizeLinearObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "scale=" << scale << ",";
+        os << "zeroPoint=" << zeroPoint << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    vector<int> QuantizeLinearObj::getOpAttrVector() const
+    {
+        return {type.underlying(), scaleBits(scale), zeroPoint};
+    }
+
+    DequantizeLinearObj::DequantizeLinearObj(GraphObj *graph, Tensor input,
+                                             Tensor output, float scale,
+                                             int zeroPoint)
+        : OperatorObj(OpType::DequantizeLinear, {input}, {output}),
+          scale(scale), zeroPoint(zeroPoint)
+    {
+        IT_ASSERT(scale > 0.0f);
+        // Int32 inputs are the accumulators of an int8 MatMul.
+        IT_ASSERT(input->getDType() == DataType::Int8 ||
+                  input->getDType() == DataType::Int32);
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> DequantizeLinearObj::inferShape(
+        const TensorVec &inputs)
+    {
+        const auto A = inputs[0];
+        return {{A->getDims()}};
+    }
+
+    vector<DataType> DequantizeLinearObj::inferDataType(
+        const TensorVec &inputs) const
+    {
+        return {DataType::Float32};
+    }
+
+    std::string DequantizeLinearObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "scale=" << scale << ",";
+        os << "zeroPoint=" << zeroPoint << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    vector<int> DequantizeLinearObj::getOpAttrVector() const
+    {
+        return {type.underlying(), scaleBits(scale), zeroPoint};
+    }
+
+} // namespace infini
@@ -0,0 +1,109 @@
+#include "operators/reshape.h"
+#include "utils/operator_utils.h"
+
+namespace infini
+{
+    ReshapeObj::ReshapeObj(GraphObj *graph, Tensor input, Tensor output,
+                           Shape dims)
+        : OperatorObj(OpType::Reshape, {input}, {output}), dims(std::move(dims))
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> ReshapeObj::inferShape(const TensorVec &inputs)
+    {
+        int wildcard = -1;
+        size_t known = 1;
+        for (size_t i = 0; i < dims.size(); ++i)
+        {
+            if (dims[i] == -1)
+            {
+                IT_ASSERT(wildcard < 0, "at most one -1 in reshape dims");
+                wildcard = (int)i;
+            }
+            else
+            {
+                IT_ASSERT(dims[i] > 0);
+                known *= dims[i];
+            }
+        }
+        auto total = inputs[0]->size();
+        Shape out = dims;
+        if (wildcard >= 0)
+        {
+            IT_ASSERT(total % known == 0);
+            out[wildcard] = (int)(total / known);
+        }
+        else
+        {
+            IT_ASSERT(known == total);
+        }
+        return {{out}};
+    }
+
+    std::string ReshapeObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "dims=" << vecToString(dims) << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    FlattenObj::FlattenObj(GraphObj *graph, Tensor input, Tensor output,
+                           int _axis)
+        : OperatorObj(OpType::Flatten, {input}, {output})
+    {
+        axis = get_real_axis(_axis, input->getRank());
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> FlattenObj::inferShape(const TensorVec &inputs)
+    {
+        const auto &dims = inputs[0]->getDims();
+        int rows = 1, cols = 1;
+        for (int i = 0; i < (int)dims.size(); ++i)
+        {
+            (i < axis ? rows : cols) *= dims[i];
+        }
+        return {{Shape{rows, cols}}};
+    }
+
+    std::string FlattenObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "axis=" << axis << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+    IdentityObj::IdentityObj(GraphObj *graph, Tensor input, Tensor output)
+        : OperatorObj(OpType::Identity, {input}, {output})
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    optional<vector<Shape>> IdentityObj::inferShape(const TensorVec &inputs)
+    {
+        return {{inputs[0]->getDims()}};
+    }
+
+    std::string IdentityObj::toString() const
+    {
+        std::ostringstream os;
+        os << type.toString() << "[" << getGuid() << "]";
+        os << "(";
+        os << vecToString(inputs[0]->getDims()) << ",";
+        os << "input=" << inputs[0]->getGuid() << ",";
+        os << "output=" << outputs[0]->getGuid() << ")";
+        return os.str();
+    }
+
+} // namespace infini
@@ -1,7 +1,21 @@
 #include "operators/unary.h"
+#include <cstring>
 
 namespace infini
 {
+    // Encode an optional clip bound for getOpAttrVector: absent bounds map to
+    // 0 and present ones to their exact bit pattern, so equal attrs mean
+    // bit-identical behavior.
+    static int clipBoundBits(const std::optional<float> &v)
+    {
+        if (!v)
+        {
+            return 0;
+        }
+        int bits;
+        std::memcpy(&bits, &*v, sizeof(bits));
+        return bits;
+    }
     UnaryObj::UnaryObj(OpType type, GraphObj *graph, Tensor input, Tensor output)
         : OperatorObj(type, {input}, {output})
     {
@@ -50,6 +64,13 @@ namespace infini
         return os.str();
     }
 
+    vector<int> ClipObj::getOpAttrVector() const
+    {
+        return {type.underlying(), minValue.has_value(),
+                clipBoundBits(minValue), maxValue.has_value(),
+                clipBoundBits(maxValue)};
+    }
+
     CastObj::CastObj(GraphObj *graph, Tensor input, Tensor output, CastType type)
         : OperatorObj(OpType::Cast, {input}, {output}), castType(type)
     {
@@ -68,6 +68,79 @@ size_t delocate_index(const Shape &shapeIndex, const Shape &shape,
     return ans;
 }
 
+BroadcastIterator::BroadcastIterator(const Shape &shapeA, const Shape &shapeB,
+                                     const Shape &shapeC)
+    : BroadcastIterator(shapeA, Shape{}, shapeB, Shape{}, shapeC) {}
+
+BroadcastIterator::BroadcastIterator(const Shape &shapeA,
+                                     const Shape &stridesA,
+                                     const Shape &shapeB,
+                                     const Shape &stridesB,
+                                     const Shape &shapeC) {
+    size_t rank = shapeC.size();
+    Shape a(rank, 1), b(rank, 1);
+    std::copy(shapeA.begin(), shapeA.end(), a.begin() + (rank - shapeA.size()));
+    std::copy(shapeB.begin(), shapeB.end(), b.begin() + (rank - shapeB.size()));
+    // Right-align the input against the output rank. Broadcast (size-1)
+    // dims never advance, so they get stride 0 whatever the nominal view
+    // stride says; empty custom strides mean dense row-major.
+    auto getStride = [&](const Shape &shape, const Shape &custom) {
+        Shape stride(rank, 0);
+        if (!custom.empty()) {
+            size_t lead = rank - custom.size();
+            for (size_t i = 0; i < custom.size(); ++i) {
+                stride[lead + i] = shape[lead + i] == 1 ? 0 : custom[i];
+            }
+            return stride;
+        }
+        int p = 1;
+        for (auto i = rank; i > 0; --i) {
+            stride[i - 1] = shape[i - 1] == 1 ? 0 : p;
+            p = p * shape[i - 1];
+        }
+        return stride;
+    };
+    Shape sA = getStride(a, stridesA), sB = getStride(b, stridesB);
+
+    // Coalesce from the innermost dim outward. Dim d can merge into the
+    // current innermost group when, for both inputs, stepping over the whole
+    // group equals one step of d (which also covers jointly-broadcast dims,
+    // where both strides are 0).
+    Shape rDims, rA, rB; // built innermost-first
+    for (auto d = rank; d-- > 0;) {
+        total *= shapeC[d];
+        if (shapeC[d] == 1)
+            continue;
+        if (!rDims.empty() &&
+            sA[d] == rA.back() * rDims.back() &&
+            sB[d] == rB.back() * rDims.back()) {
+            rDims.back() *= shapeC[d];
+        } else {
+            rDims.push_back(shapeC[d]);
+            rA.push_back(sA[d]);
+            rB.push_back(sB[d]);
+        }
+    }
+    if (rDims.empty()) { // all dims are 1
+        rDims.push_back(1);
+        rA.push_back(1);
+        rB.push_back(1);
+    }
+    dims.assign(rDims.rbegin(), rDims.rend());
+    strideA.assign(rA.rbegin(), rA.rend());
+    strideB.assign(rB.rbegin(), rB.rend());
+}
+
+void BroadcastIterator::locate(size_t run, size_t &offA, size_t &offB) const {
+    offA = offB = 0;
+    for (auto d = dims.size() - 1; d-- > 0;) {
+        size_t idx = run % dims[d];
+        run /= dims[d];
+        offA += idx * strideA[d];
+        offB += idx * strideB[d];
+    }
+}
+
 std::string device_to_str(Device device) {
     std::string deviceStr;
     switch (device) {
@@ -0,0 +1,107 @@
+#include "utils/thread_pool.h"
+#include <cstdlib>
+
+namespace infini {
+
+// Set while a worker (or the caller) is executing a task, so nested
+// parallelFor calls degrade to inline execution instead of deadlocking on
+// the pool state.
+static thread_local bool inParallelRegion = false;
+
+int ThreadPool::defaultNumThreads() {
+    if (const char *env = std::getenv("INFINI_NUM_THREADS")) {
+        int n = std::atoi(env);
+        if (n > 0)
+            return n;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? (int)hw : 1;
+}
+
+ThreadPool::ThreadPool(int numThreads) : nThreads(0) {
+    start(numThreads > 0 ? numThreads : defaultNumThreads());
+}
+
+ThreadPool::~ThreadPool() { stop(); }
+
+void ThreadPool::start(int numThreads) {
+    nThreads = numThreads;
+    // The calling thread counts as one worker; extra threads make up the
+    // difference.
+    for (int i = 1; i < numThreads; ++i)
+        workers.emplace_back([this] { workerLoop(); });
+}
+
+void ThreadPool::stop() {
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        shutdown = true;
+    }
+    cvTask.notify_all();
+    for (auto &w : workers)
+        w.join();
+    workers.clear();
+    shutdown = false;
+}
+
+void ThreadPool::setNumThreads(int numThreads) {
+    if (numThreads <= 0)
+        numThreads = defaultNumThreads();
+    if (numThreads == nThreads)
+        return;
+    stop();
+    start(numThreads);
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+    std::unique_lock<std::mutex> lk(mtx);
+    while (true) {
+        cvTask.wait(lk, [&] { return shutdown || generation != seenGeneration; });
+        if (shutdown)
+            return;
+        seenGeneration = generation;
+        runTasks(lk);
+    }
+}
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex> &lk) {
+    while (nextTask < tasks.size()) {
+        Task t = tasks[nextTask++];
+        lk.unlock();
+        inParallelRegion = true;
+        (*job)(t.begin, t.end);
+        inParallelRegion = false;
+        lk.lock();
+        if (--pendingTasks == 0)
+            cvDone.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(size_t n, size_t grainSize,
+                             const std::function<void(size_t, size_t)> &fn) {
+    if (n == 0)
+        return;
+    if (grainSize == 0)
+        grainSize = 1;
+    size_t chunk = std::max(grainSize, (n + nThreads - 1) / nThreads);
+    if (nThreads <= 1 || n <= chunk || inParallelRegion) {
+        fn(0, n);
+        return;
+    }
+    std::lock_guard<std::mutex> submitLock(submitMtx);
+    std::unique_lock<std::mutex> lk(mtx);
+    job = &fn;
+    tasks.clear();
+    for (size_t b = 0; b < n; b += chunk)
+        tasks.push_back({b, std::min(b + chunk, n)});
+    nextTask = 0;
+    pendingTasks = tasks.size();
+    ++generation;
+    cvTask.notify_all();
+    runTasks(lk);
+    cvDone.wait(lk, [&] { return pendingTasks == 0; });
+    job = nullptr;
+}
+
+} // namespace infini
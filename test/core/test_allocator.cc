@@ -1,6 +1,8 @@
 #include "core/graph.h"
 #include "core/kernel.h"
 #include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
 #include "operators/unary.h"
 
 #include "test.h"
@@ -51,6 +53,230 @@ namespace infini
         EXPECT_EQ(offsetC, offsetD);
     }
 
+    TEST(Allocator, testAlignment)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        {
+            // consecutive small tensors land on separate cache lines
+            Allocator allocator = Allocator(runtime);
+            EXPECT_EQ(allocator.alloc(24), (size_t)0);
+            EXPECT_EQ(allocator.alloc(24), (size_t)64);
+            // per-allocation alignment request (e.g. a packing buffer)
+            EXPECT_EQ(allocator.alloc(24, 256) % 256, (size_t)0);
+        }
+        {
+            // large allocations get their own pages when enabled
+            Allocator allocator = Allocator(runtime, 64, 4096);
+            allocator.alloc(24);
+            EXPECT_EQ(allocator.alloc(8192) % 4096, (size_t)0);
+        }
+    }
+
+    TEST(Allocator, testBestFit)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Allocator allocator = Allocator(runtime);
+        // layout: a(24) b(24) c(48) d(24) e(24)
+        size_t offsetA = allocator.alloc(24);
+        size_t offsetB = allocator.alloc(24);
+        allocator.alloc(48);
+        size_t offsetD = allocator.alloc(24);
+        allocator.alloc(24);
+        // free a+b (merge into 48) and d (24): two holes of different sizes
+        allocator.free(offsetA, 24);
+        allocator.free(offsetB, 24);
+        allocator.free(offsetD, 24);
+        // a 24-byte request best-fits the 24-byte hole, not the 48-byte one
+        EXPECT_EQ(allocator.alloc(24), offsetD);
+        // the 48-byte hole is still intact for a matching request
+        EXPECT_EQ(allocator.alloc(48), offsetA);
+    }
+
+    TEST(Allocator, testLifetimeReuse)
+    {
+        // x -> relu -> a -> relu -> b -> relu -> c -> relu -> y
+        // a's last consumer is the second relu, so c (allocated for the
+        // third relu) reuses a's bytes; the graph still computes correctly.
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({64}, DataType::Float32);
+        auto r1 = g->addOp<ReluObj>(x, nullptr);
+        auto r2 = g->addOp<ReluObj>(r1->getOutput(), nullptr);
+        auto r3 = g->addOp<ReluObj>(r2->getOutput(), nullptr);
+        auto r4 = g->addOp<ReluObj>(r3->getOutput(), nullptr);
+        g->dataMalloc();
+
+        EXPECT_EQ(r3->getOutput()->getRawDataPtr<void *>(),
+                  r1->getOutput()->getRawDataPtr<void *>());
+        // the pinned input and output keep their own storage
+        EXPECT_NE(r4->getOutput()->getRawDataPtr<void *>(),
+                  x->getRawDataPtr<void *>());
+
+        x->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(r4->getOutput()->equalData(x));
+    }
+
+    TEST(Allocator, testInplaceElementwise)
+    {
+        // the add output is read only by the relu, so the relu writes over
+        // it in place; the graph inputs keep their own storage
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({2, 3}, DataType::Float32);
+        Tensor y = g->addTensor({2, 3}, DataType::Float32);
+        auto add = g->addOp<AddObj>(x, y, nullptr);
+        auto relu = g->addOp<ReluObj>(add->getOutput(), nullptr);
+        g->dataMalloc();
+
+        EXPECT_EQ(relu->getOutput()->getRawDataPtr<void *>(),
+                  add->getOutput()->getRawDataPtr<void *>());
+        EXPECT_NE(add->getOutput()->getRawDataPtr<void *>(),
+                  x->getRawDataPtr<void *>());
+
+        // -3..2 plus 1, clamped by the relu
+        x->setData([](void *data, size_t size, DataType) {
+            auto ptr = reinterpret_cast<float *>(data);
+            for (size_t i = 0; i < size; ++i)
+                ptr[i] = (float)i - 3;
+        });
+        y->setData(OneGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(relu->getOutput()->equalData(
+            vector<float>{0, 0, 0, 1, 2, 3}));
+    }
+
+    TEST(Allocator, testResetRecyclesArena)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Allocator allocator = Allocator(runtime);
+        allocator.alloc(1024);
+        void *warm = allocator.getPtr();
+        // a smaller follow-up plan reuses the same backing buffer
+        allocator.reset();
+        allocator.alloc(256);
+        EXPECT_EQ(allocator.getPtr(), warm);
+        // a larger plan grows the arena
+        allocator.reset();
+        allocator.alloc(1 << 20);
+        EXPECT_NE(allocator.getPtr(), nullptr);
+    }
+
+    TEST(Allocator, testGraphAdoptsArena)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g1 = make_ref<GraphObj>(runtime);
+        Tensor x1 = g1->addTensor({2, 3}, DataType::Float32);
+        g1->addOp<ReluObj>(x1, nullptr);
+        g1->dataMalloc();
+        void *base = x1->getRawDataPtr<void *>(); // offset 0 of the arena
+
+        // the replacement graph reuses the warm pages
+        Graph g2 = make_ref<GraphObj>(runtime, std::move(g1->getAllocator()));
+        Tensor x2 = g2->addTensor({2, 3}, DataType::Float32);
+        auto relu = g2->addOp<ReluObj>(x2, nullptr);
+        g2->dataMalloc();
+        EXPECT_EQ(x2->getRawDataPtr<void *>(), base);
+
+        x2->setData(IncrementalGenerator());
+        runtime->run(g2);
+        EXPECT_TRUE(relu->getOutput()->equalData(x2));
+    }
+
+    TEST(Allocator, testHugePages)
+    {
+        // works whether or not the machine has a hugetlb pool: the
+        // MAP_HUGETLB attempt falls back to madvise(MADV_HUGEPAGE)
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        g->getAllocator().setHugePages(true);
+        Tensor x = g->addTensor({1 << 20}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(relu->getOutput()->equalData(x));
+    }
+
+    TEST(Allocator, testWarmup)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({1 << 16}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->dataMalloc();
+        EXPECT_GE(g->warmup(), 0.0);
+        // the dummy inference leaves the graph fully functional
+        x->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(relu->getOutput()->equalData(x));
+    }
+
+    TEST(Allocator, testTracing)
+    {
+        // a matmul chain (not in-place eligible) exercises the planner's
+        // alloc/free churn; the trace attributes the peak to the tensors
+        // live at the high-water mark
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({8, 8}, DataType::Float32);
+        Tensor w = g->addTensor({8, 8}, DataType::Float32);
+        auto m1 = g->addOp<MatmulObj>(x, w, nullptr);
+        auto m2 = g->addOp<MatmulObj>(m1->getOutput(), w, nullptr);
+        auto m3 = g->addOp<MatmulObj>(m2->getOutput(), w, nullptr);
+        auto m4 = g->addOp<MatmulObj>(m3->getOutput(), w, nullptr);
+        g->getAllocator().setTracing(true);
+        g->dataMalloc();
+
+        const auto &trace = g->getAllocator().getTrace();
+        // 6 allocations (x, w, the 4 matmul outputs) and the 3 dead
+        // intermediates freed
+        size_t nAllocs = 0, nFrees = 0;
+        for (const auto &e : trace)
+            (e.isAlloc ? nAllocs : nFrees)++;
+        EXPECT_EQ(nAllocs, (size_t)6);
+        EXPECT_EQ(nFrees, (size_t)3);
+        // the prologue input carries op index -1, op-driven events don't
+        EXPECT_EQ(trace.front().opIndex, -1);
+        EXPECT_EQ(trace.front().fuid, x->getFuid());
+        EXPECT_GE(trace.back().opIndex, 0);
+
+        auto json = g->getAllocator().traceToChromeJson();
+        EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+        EXPECT_NE(json.find("\"used bytes\""), std::string::npos);
+
+        auto table = g->getAllocator().peakContributionTable();
+        // peak = x, w and two chain tensors live at once, 256 bytes each
+        EXPECT_NE(table.find("peak 1024 bytes across 4 tensors"),
+                  std::string::npos);
+    }
+
+    TEST(Allocator, testTraceSaveReplay)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Allocator allocator(runtime);
+        allocator.setTracing(true);
+        // interleaved lifetimes, captured and replayed ordinal by ordinal
+        size_t a = allocator.alloc(512);
+        size_t b = allocator.alloc(256);
+        allocator.free(a, 512);
+        size_t c = allocator.alloc(128);
+        allocator.free(b, 256);
+        allocator.free(c, 128);
+
+        const char *path = "allocator_trace_test.itat";
+        allocator.saveTrace(path);
+
+        // replaying under the same policy reproduces the same peak and
+        // ends with the whole arena coalesced back into one free block
+        Allocator replayed(runtime);
+        auto stats = replayed.replayTrace(path);
+        EXPECT_EQ(stats.events, (size_t)6);
+        EXPECT_EQ(stats.peakBytes, (size_t)768);
+        EXPECT_EQ(stats.freeBytes, stats.largestFreeBlock);
+        std::remove(path);
+    }
+
     TEST(Allocator, testGetPtr)
     {
         Shape shape = Shape{1, 2, 2, 3};
@@ -0,0 +1,47 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Graph, CloneSharesPayloadAndConnectivity)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({2, 3}, DataType::Float32);
+        Tensor w = g->addTensor({3, 4}, DataType::Float32);
+        auto matmul = g->addOp<MatmulObj>(x, w, nullptr);
+        auto relu = g->addOp<ReluObj>(matmul->getOutput(), nullptr);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+        w->setData(OneGenerator());
+        runtime->run(g);
+
+        Graph copy = g->clone();
+        EXPECT_EQ(copy->getOperators().size(), g->getOperators().size());
+        EXPECT_EQ(copy->getTensors().size(), g->getTensors().size());
+        EXPECT_TRUE(copy->checkValid());
+
+        // inputs and weights are shared by refcount, intermediates are not
+        Tensor wCopy = copy->getTensor(w->getFuid());
+        ASSERT_TRUE(wCopy != nullptr);
+        EXPECT_EQ(wCopy->getRawDataPtr<void *>(), w->getRawDataPtr<void *>());
+        Tensor outCopy = copy->getTensor(relu->getOutput()->getFuid());
+        ASSERT_TRUE(outCopy != nullptr);
+        EXPECT_FALSE(outCopy->hasData());
+
+        // the clone runs independently and reproduces the original's result
+        copy->dataMalloc();
+        runtime->run(copy);
+        EXPECT_TRUE(outCopy->equalData(relu->getOutput()));
+
+        // rewriting the clone leaves the original untouched
+        copy->addOp<TransposeObj>(outCopy, nullptr, vector<int>{1, 0});
+        EXPECT_EQ(copy->getOperators().size(), (size_t)3);
+        EXPECT_EQ(g->getOperators().size(), (size_t)2);
+    }
+}
@@ -0,0 +1,76 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+
+#include "test.h"
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace infini
+{
+    TEST(Concurrency, GuidsAreUniqueAcrossThreads)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        std::mutex mtx;
+        std::set<UidBaseType> guids;
+        size_t total = 0;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&]
+            {
+                std::vector<UidBaseType> local;
+                for (int i = 0; i < 1000; ++i)
+                {
+                    auto tensor = make_ref<TensorObj>(
+                        Shape{1}, DataType::Float32, runtime);
+                    local.push_back(tensor->getGuid());
+                }
+                std::lock_guard<std::mutex> lock(mtx);
+                guids.insert(local.begin(), local.end());
+                total += local.size();
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        // a torn counter would show up as duplicate ids
+        EXPECT_EQ(guids.size(), total);
+    }
+
+    TEST(Concurrency, TwoGraphsOnSeparateThreads)
+    {
+        // one runtime (and so one worker pool) per model, the intended
+        // layout for serving several models in one process
+        auto runImage = [](int seed, float *firstOut)
+        {
+            Runtime runtime = make_ref<NativeCpuRuntimeObj>();
+            Graph g = make_ref<GraphObj>(runtime);
+            auto x = g->addTensor({32, 32}, DataType::Float32);
+            auto w = g->addTensor({32, 32}, DataType::Float32);
+            auto matmul = g->addOp<MatmulObj>(x, w, nullptr);
+            auto add = g->addOp<AddObj>(matmul->getOutput(), x, nullptr);
+            g->dataMalloc();
+            x->setData(RandomGenerator(seed));
+            w->setData(OneGenerator());
+            for (int i = 0; i < 20; ++i)
+            {
+                runtime->run(g);
+            }
+            *firstOut = add->getOutput()->getRawDataPtr<float *>()[0];
+        };
+
+        float a = 0, b = 0, aAgain = 0;
+        std::thread ta(runImage, 1, &a);
+        std::thread tb(runImage, 2, &b);
+        ta.join();
+        tb.join();
+        // same graph run single-threaded gives the same numbers
+        runImage(1, &aAgain);
+        EXPECT_FLOAT_EQ(a, aAgain);
+        EXPECT_NE(a, b);
+    }
+} // namespace infini
@@ -0,0 +1,63 @@
+#include "core/graph.h"
+#include "core/blob.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    // Bind constant data to a tensor before optimize(), the way weights are
+    // loaded: a private blob plus a generator.
+    static void bindConstant(const Runtime &runtime, const Tensor &t,
+                             std::function<void(void *, size_t, DataType)> gen)
+    {
+        t->setDataBlob(make_ref<BlobObj>(runtime, runtime->alloc(t->getBytes())));
+        t->setData(gen);
+    }
+
+    TEST(Graph, FoldConstantChain)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor c1 = g->addTensor({2, 3}, DataType::Float32);
+        Tensor c2 = g->addTensor({2, 3}, DataType::Float32);
+        bindConstant(runtime, c1, IncrementalGenerator()); // 0..5
+        bindConstant(runtime, c2, ValGenerator<2>());
+        auto sub = g->addOp<SubObj>(c1, c2, nullptr);
+        auto relu = g->addOp<ReluObj>(sub->getOutput(), nullptr);
+        auto out = relu->getOutput();
+
+        g->optimize();
+        // the whole chain was computed at optimization time
+        EXPECT_EQ(g->getOperators().size(), (size_t)0);
+        EXPECT_TRUE(out->hasData());
+        EXPECT_TRUE(out->equalData(vector<float>{0, 0, 0, 1, 2, 3}));
+    }
+
+    TEST(Graph, FoldConstantOnlyConstSubgraph)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor w = g->addTensor({2, 2}, DataType::Float32);
+        bindConstant(runtime, w, IncrementalGenerator()); // 0,1,2,3
+        Tensor x = g->addTensor({2, 2}, DataType::Float32); // runtime input
+        auto trans = g->addOp<TransposeObj>(w, nullptr, vector<int>{1, 0});
+        auto add = g->addOp<AddObj>(x, trans->getOutput(), nullptr);
+        auto out = add->getOutput();
+
+        g->optimize();
+        // the transpose folds away; the add still depends on x
+        EXPECT_EQ(g->getOperators().size(), (size_t)1);
+        auto wT = g->getOperators()[0]->getInputs(1);
+        EXPECT_TRUE(wT->hasData());
+        EXPECT_TRUE(wT->equalData(vector<float>{0, 2, 1, 3}));
+
+        g->dataMalloc();
+        x->setData(ValGenerator<1>());
+        runtime->run(g);
+        EXPECT_TRUE(out->equalData(vector<float>{1, 3, 2, 4}));
+    }
+}
@@ -0,0 +1,51 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/transpose.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Graph, CommonSubexpressionElimination)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor i1 = g->addTensor({2, 3}, DataType::Float32);
+        // the exporter duplicated the same transpose twice
+        auto t1 = g->addOp<TransposeObj>(i1, nullptr, vector<int>{1, 0});
+        auto t2 = g->addOp<TransposeObj>(i1, nullptr, vector<int>{1, 0});
+        auto concat = g->addOp<ConcatObj>(
+            TensorVec{t1->getOutput(), t2->getOutput()}, nullptr, 0);
+        auto out = concat->getOutput();
+
+        g->optimize();
+        // one transpose survives and feeds the concat twice
+        EXPECT_EQ(g->getOperators().size(), (size_t)2);
+        auto merged = as<ConcatObj>(g->getOperators()[1]);
+        ASSERT_TRUE(merged != nullptr);
+        EXPECT_EQ(merged->getInputs(0), merged->getInputs(1));
+
+        g->dataMalloc();
+        i1->setData(IncrementalGenerator()); // 0..5
+        runtime->run(g);
+        EXPECT_TRUE(out->equalData(
+            vector<float>{0, 3, 1, 4, 2, 5, 0, 3, 1, 4, 2, 5}));
+    }
+
+    TEST(Graph, DeadTensorElimination)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor i1 = g->addTensor({2, 2}, DataType::Float32);
+        Tensor i2 = g->addTensor({2, 2}, DataType::Float32);
+        g->addOp<AddObj>(i1, i2, nullptr);
+        // an input the exporter declared but nothing reads
+        g->addTensor({16, 16}, DataType::Float32);
+
+        g->optimize();
+        EXPECT_EQ(g->getOperators().size(), (size_t)1);
+        EXPECT_EQ(g->getTensors().size(), (size_t)3);
+    }
+}
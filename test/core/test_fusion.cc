@@ -0,0 +1,73 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Graph, FuseElementWiseActivation)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor i1 = g->addTensor({2, 3}, DataType::Float32);
+        Tensor i2 = g->addTensor({2, 3}, DataType::Float32);
+        auto sub = g->addOp<SubObj>(i1, i2, nullptr);
+        auto relu = g->addOp<ReluObj>(sub->getOutput(), nullptr);
+        auto out = relu->getOutput();
+
+        g->optimize();
+        EXPECT_EQ(g->getOperators().size(), (size_t)1);
+        EXPECT_EQ(g->getTensors().size(), (size_t)3);
+        auto fused = as<FusedElemActObj>(g->getOperators()[0]);
+        ASSERT_TRUE(fused != nullptr);
+        EXPECT_EQ(fused->getElemType(), OpType::Sub);
+        EXPECT_EQ(fused->getActType(), OpType::Relu);
+        EXPECT_EQ(fused->getOutput(), out);
+
+        g->dataMalloc();
+        i1->setData(IncrementalGenerator()); // 0..5
+        i2->setData(ValGenerator<2>());
+        runtime->run(g);
+        EXPECT_TRUE(out->equalData(vector<float>{0, 0, 0, 1, 2, 3}));
+    }
+
+    TEST(Graph, FuseElementWiseClip)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor i1 = g->addTensor({2, 2}, DataType::Float32);
+        Tensor i2 = g->addTensor({2, 2}, DataType::Float32);
+        auto add = g->addOp<AddObj>(i1, i2, nullptr);
+        auto clip =
+            g->addOp<ClipObj>(add->getOutput(), nullptr, 1.0f, 4.0f);
+        auto out = clip->getOutput();
+
+        g->optimize();
+        EXPECT_EQ(g->getOperators().size(), (size_t)1);
+
+        g->dataMalloc();
+        i1->setData(IncrementalGenerator()); // 0..3
+        i2->setData(IncrementalGenerator());
+        runtime->run(g);
+        // 0,2,4,6 clipped to [1,4]
+        EXPECT_TRUE(out->equalData(vector<float>{1, 2, 4, 4}));
+    }
+
+    TEST(Graph, NoFusionWhenIntermediateShared)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor i1 = g->addTensor({2, 2}, DataType::Float32);
+        Tensor i2 = g->addTensor({2, 2}, DataType::Float32);
+        auto add = g->addOp<AddObj>(i1, i2, nullptr);
+        // the intermediate feeds two distinct consumers, so it must stay
+        // materialized (two identical ones would be CSE-merged instead)
+        g->addOp<ReluObj>(add->getOutput(), nullptr);
+        g->addOp<ClipObj>(add->getOutput(), nullptr, 0.0f, 1.0f);
+
+        g->optimize();
+        EXPECT_EQ(g->getOperators().size(), (size_t)3);
+    }
+}
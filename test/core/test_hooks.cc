@@ -0,0 +1,80 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+#include <atomic>
+
+namespace infini
+{
+    namespace
+    {
+        struct HookCounts
+        {
+            std::atomic<int> graphBegin{0};
+            std::atomic<int> graphEnd{0};
+            std::atomic<int> preOp{0};
+            std::atomic<int> postOp{0};
+            std::atomic<int64_t> opNs{0};
+            std::atomic<int64_t> graphNs{0};
+        };
+    } // namespace
+
+    TEST(ExecutionHooks, PerOpAndGraphCallbacks)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({64}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->addOp<ClipObj>(relu->getOutput(), nullptr, 0.0f, 1.0f);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+
+        HookCounts counts;
+        ExecutionHooks hooks;
+        hooks.ctx = &counts;
+        hooks.graphBegin = [](void *ctx)
+        { static_cast<HookCounts *>(ctx)->graphBegin++; };
+        hooks.graphEnd = [](void *ctx, int64_t ns)
+        {
+            auto *c = static_cast<HookCounts *>(ctx);
+            c->graphEnd++;
+            c->graphNs += ns;
+        };
+        hooks.preOp = [](void *ctx, const Operator &op)
+        {
+            EXPECT_TRUE(op != nullptr);
+            static_cast<HookCounts *>(ctx)->preOp++;
+        };
+        hooks.postOp = [](void *ctx, const Operator &op, int64_t ns)
+        {
+            EXPECT_TRUE(op != nullptr);
+            auto *c = static_cast<HookCounts *>(ctx);
+            c->postOp++;
+            c->opNs += ns;
+        };
+        runtime->setHooks(hooks);
+
+        runtime->run(g);
+        EXPECT_EQ(counts.graphBegin.load(), 1);
+        EXPECT_EQ(counts.graphEnd.load(), 1);
+        EXPECT_EQ(counts.preOp.load(), 2);
+        EXPECT_EQ(counts.postOp.load(), 2);
+        // per-op time is a slice of the whole-graph time
+        EXPECT_GT(counts.graphNs.load(), 0);
+        EXPECT_LE(counts.opNs.load(), counts.graphNs.load());
+
+        // plan runs fire the same surface
+        auto plan = g->compile();
+        runtime->run(plan);
+        EXPECT_EQ(counts.preOp.load(), 4);
+        EXPECT_EQ(counts.graphEnd.load(), 2);
+
+        // a default-constructed value uninstalls everything
+        runtime->setHooks(ExecutionHooks());
+        runtime->run(g);
+        EXPECT_EQ(counts.preOp.load(), 4);
+        EXPECT_EQ(counts.graphEnd.load(), 2);
+    }
+} // namespace infini
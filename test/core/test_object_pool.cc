@@ -0,0 +1,42 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(ObjectPool, ObjectsOutliveGraph)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Tensor keptTensor;
+        Operator keptOp;
+        {
+            Graph g = make_ref<GraphObj>(runtime);
+            keptTensor = g->addTensor({2, 3}, DataType::Float32);
+            keptOp = g->addOp<ReluObj>(keptTensor, nullptr);
+        }
+        // the pool stays alive as long as any of its objects does
+        EXPECT_EQ(keptTensor->getDims(), (Shape{2, 3}));
+        EXPECT_EQ(keptOp->getOpType(), OpType::Relu);
+    }
+
+    TEST(ObjectPool, LargeGraphConstruction)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({16}, DataType::Float32);
+        Tensor cur = x;
+        Operator last;
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto op = g->addOp<ReluObj>(cur, nullptr);
+            cur = op->getOutput();
+            last = op;
+        }
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+        runtime->run(g);
+        EXPECT_TRUE(last->getOutput()->equalData(x));
+    }
+} // namespace infini
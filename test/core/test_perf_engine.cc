@@ -0,0 +1,71 @@
+#include "core/graph.h"
+#include "core/perf_engine.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    static int altReluCalls = 0;
+
+    // a second Relu candidate alongside the stock NativeRelu, so the
+    // PerfEngine has a real choice to time
+    class AltRelu : public CpuKernelWithoutConfig
+    {
+        void compute(const Operator &_op,
+                     const RuntimeObj *context) const override
+        {
+            ++altReluCalls;
+            auto op = as<UnaryObj>(_op);
+            auto inptr = op->getInputs(0)->getRawDataPtr<float *>();
+            auto outptr = op->getOutput()->getRawDataPtr<float *>();
+            for (size_t i = 0, n = op->getOutput()->size(); i < n; ++i)
+                outptr[i] = std::max(0.0f, inptr[i]);
+        }
+    };
+    REGISTER_KERNEL(Device::CPU, OpType::Relu, AltRelu, "altReluCpu");
+
+    TEST(PerfEngine, TunesAndCaches)
+    {
+        auto &engine = PerfEngine::getInstance();
+        engine.clear();
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({2, 64}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+
+        runtime->run(g); // first encounter: times both candidates
+        EXPECT_EQ(engine.size(), (size_t)1);
+        EXPECT_GT(altReluCalls, 0);
+
+        int tunedCalls = altReluCalls;
+        runtime->run(g); // cache hit: only the winner runs
+        EXPECT_TRUE(altReluCalls == tunedCalls ||
+                    altReluCalls == tunedCalls + 1);
+        EXPECT_TRUE(relu->getOutput()->equalData(x));
+    }
+
+    TEST(PerfEngine, SaveLoadRoundtrip)
+    {
+        auto &engine = PerfEngine::getInstance();
+        engine.clear();
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({2, 64}, DataType::Float32);
+        g->addOp<ReluObj>(x, nullptr);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+        runtime->run(g);
+
+        const char *path = "perf_engine_test.cache";
+        EXPECT_TRUE(engine.save(path));
+        engine.clear();
+        EXPECT_EQ(engine.size(), (size_t)0);
+        EXPECT_TRUE(engine.load(path));
+        EXPECT_EQ(engine.size(), (size_t)1);
+        std::remove(path);
+    }
+} // namespace infini
@@ -0,0 +1,74 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Profiler, PerOpRecords)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        auto cpu = as<NativeCpuRuntimeObj>(runtime);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({8, 8}, DataType::Float32);
+        auto b = g->addTensor({8, 8}, DataType::Float32);
+        auto matmul = g->addOp<MatmulObj>(a, b, nullptr);
+        auto relu = g->addOp<ReluObj>(matmul->getOutput(), nullptr);
+        g->dataMalloc();
+        a->setData(IncrementalGenerator());
+        b->setData(IncrementalGenerator());
+
+        cpu->getProfiler().clear();
+        cpu->setProfiling(true);
+        const int nRuns = 5;
+        for (int i = 0; i < nRuns; ++i)
+            runtime->run(g);
+        cpu->setProfiling(false);
+        runtime->run(g); // not recorded
+
+        EXPECT_EQ(cpu->getProfiler().numRuns(), (uint64_t)nRuns);
+        auto csv = cpu->getProfiler().toCsv();
+        EXPECT_NE(csv.find("MatMul," + std::to_string(nRuns)),
+                  std::string::npos);
+        EXPECT_NE(csv.find("Relu," + std::to_string(nRuns)),
+                  std::string::npos);
+        auto json = cpu->getProfiler().toJson();
+        EXPECT_NE(json.find("\"op_type\": \"MatMul\""), std::string::npos);
+        EXPECT_NE(json.find("\"p99_ms\""), std::string::npos);
+
+        cpu->getProfiler().clear();
+        EXPECT_EQ(cpu->getProfiler().numRuns(), (uint64_t)0);
+    }
+
+    TEST(Profiler, RooflineReport)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        auto cpu = as<NativeCpuRuntimeObj>(runtime);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({8, 8}, DataType::Float32);
+        auto b = g->addTensor({8, 8}, DataType::Float32);
+        auto matmul = g->addOp<MatmulObj>(a, b, nullptr);
+        auto relu = g->addOp<ReluObj>(matmul->getOutput(), nullptr);
+        g->dataMalloc();
+        a->setData(IncrementalGenerator());
+        b->setData(IncrementalGenerator());
+
+        // counters are static properties of the ops
+        EXPECT_EQ(matmul->getFlops(), (size_t)2 * 8 * 8 * 8);
+        EXPECT_EQ(matmul->getBytes(), (size_t)3 * 8 * 8 * sizeof(float));
+        EXPECT_EQ(relu->getFlops(), (size_t)8 * 8);
+
+        cpu->getProfiler().clear();
+        cpu->setProfiling(true);
+        runtime->run(g);
+        cpu->setProfiling(false);
+
+        auto report = g->rooflineReport(100.0, 10.0);
+        EXPECT_NE(report.find("MatMul"), std::string::npos);
+        EXPECT_NE(report.find("bound"), std::string::npos);
+        // the tiny relu just moves bytes, so it sits under the bandwidth roof
+        EXPECT_NE(report.find("bandwidth"), std::string::npos);
+    }
+} // namespace infini
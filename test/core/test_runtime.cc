@@ -0,0 +1,53 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Runtime, AllocModes)
+    {
+        auto runtime = NativeCpuRuntimeObj::getInstance();
+        runtime->setNumThreads(4);
+        // every mode yields usable (and, except Untouched, zeroed) memory
+        for (auto mode : {AllocMode::Zeroed, AllocMode::Untouched,
+                          AllocMode::FirstTouch, AllocMode::Interleaved})
+        {
+            runtime->setAllocMode(mode);
+            Graph g = make_ref<GraphObj>(runtime);
+            Tensor x = g->addTensor({1024}, DataType::Float32);
+            auto relu = g->addOp<ReluObj>(x, nullptr);
+            g->dataMalloc();
+            x->setData(IncrementalGenerator());
+            runtime->run(g);
+            EXPECT_TRUE(relu->getOutput()->equalData(x));
+        }
+
+        runtime->setAllocMode(AllocMode::FirstTouch);
+        char *ptr = static_cast<char *>(runtime->alloc(1 << 16));
+        bool allZero = true;
+        for (size_t i = 0; i < (1 << 16); ++i)
+            allZero = allZero && ptr[i] == 0;
+        EXPECT_TRUE(allZero);
+        runtime->dealloc(ptr);
+
+        runtime->setAllocMode(AllocMode::Zeroed);
+        runtime->setNumThreads(1);
+    }
+
+    TEST(Runtime, RunAsync)
+    {
+        auto runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({256}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+        auto plan = g->compile();
+        // the token completes once the plan has run
+        auto token = runtime->runAsync(plan);
+        token.get();
+        EXPECT_TRUE(relu->getOutput()->equalData(x));
+    }
+} // namespace infini
@@ -0,0 +1,154 @@
+#include "core/session.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Session, RebindAndRerun)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({2, 4}, DataType::Float32);
+        auto w = g->addTensor({4, 4}, DataType::Float32);
+        auto matmul = g->addOp<MatmulObj>(x, w, nullptr);
+        g->addOp<AddObj>(matmul->getOutput(), x, nullptr);
+
+        auto session = make_ref<SessionObj>(g);
+        ASSERT_EQ(session->getInputs().size(), (size_t)2);
+        session->getInputs()[1]->setData(OneGenerator());
+
+        // aligned request buffer: adopted without a copy
+        alignas(64) float request[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        EXPECT_TRUE(session->bindInput(0, request, sizeof(request)));
+        EXPECT_EQ(session->getInputs()[0]->getRawDataPtr<float *>(), request);
+        session->run();
+        auto out = session->getOutputs()[0];
+        // row 0: matmul row sums are 1+2+3+4 = 10, plus x
+        EXPECT_FLOAT_EQ(out->getRawDataPtr<float *>()[0], 11.0f);
+
+        // rebinding the same pointer is a no-op; new bytes are picked up
+        request[0] = 9;
+        EXPECT_TRUE(session->bindInput(0, request, sizeof(request)));
+        session->run();
+        EXPECT_FLOAT_EQ(out->getRawDataPtr<float *>()[0], 27.0f);
+
+        // a misaligned buffer is copied into the planned arena slot
+        alignas(64) float backing[9];
+        float *misaligned = backing + 1;
+        for (int i = 0; i < 8; ++i)
+            misaligned[i] = 1.0f;
+        EXPECT_FALSE(session->bindInput(0, misaligned, 8 * sizeof(float)));
+        EXPECT_NE(session->getInputs()[0]->getRawDataPtr<float *>(),
+                  misaligned);
+        session->run();
+        EXPECT_FLOAT_EQ(out->getRawDataPtr<float *>()[0], 5.0f);
+    }
+
+    TEST(Session, RunWithBufferVector)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({16}, DataType::Float32);
+        auto b = g->addTensor({16}, DataType::Float32);
+        g->addOp<MulObj>(a, b, nullptr);
+
+        // parallel sessions serve through runParallel
+        auto session = make_ref<SessionObj>(g, true);
+        alignas(64) float lhs[16], rhs[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            lhs[i] = i;
+            rhs[i] = 2;
+        }
+        session->run({lhs, rhs});
+        auto *out = session->getOutputs()[0]->getRawDataPtr<float *>();
+        for (int i = 0; i < 16; ++i)
+            EXPECT_FLOAT_EQ(out[i], 2.0f * i);
+    }
+
+    TEST(Session, AsyncPipelined)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({2, 4}, DataType::Float32);
+        auto w = g->addTensor({4, 3}, DataType::Float32);
+        g->addOp<MatmulObj>(x, w, nullptr);
+
+        auto session = make_ref<SessionObj>(g, false, true);
+        std::vector<float> bufW(4 * 3);
+        for (size_t i = 0; i < bufW.size(); ++i)
+            bufW[i] = 0.5f * (float)i - 2.0f;
+
+        // submit a burst: request N+1's staging copy overlaps request N's
+        // compute, and each result lands in its own output buffer before
+        // the token completes
+        const int R = 6;
+        std::vector<std::vector<float>> reqX(R), reqOut(R);
+        std::vector<std::shared_future<void>> tokens;
+        for (int r = 0; r < R; ++r)
+        {
+            reqX[r].resize(2 * 4);
+            for (int i = 0; i < 8; ++i)
+                reqX[r][i] = (float)(r * 8 + i);
+            reqOut[r].assign(2 * 3, -1.0f);
+            tokens.push_back(session->runAsync({reqX[r].data(), bufW.data()},
+                                               {reqOut[r].data()}));
+        }
+        for (auto &token : tokens)
+            token.get();
+        for (int r = 0; r < R; ++r)
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    float acc = 0;
+                    for (int k = 0; k < 4; ++k)
+                        acc += reqX[r][i * 4 + k] * bufW[k * 3 + j];
+                    EXPECT_NEAR(reqOut[r][i * 3 + j], acc, 1e-4f);
+                }
+            }
+        }
+    }
+
+    TEST(Session, MixedSyncAndAsync)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({8}, DataType::Float32);
+        auto b = g->addTensor({8}, DataType::Float32);
+        auto add = g->addOp<AddObj>(a, b, nullptr);
+        auto session = make_ref<SessionObj>(g, false, true);
+        auto out = session->getOutputs()[0];
+
+        alignas(64) float pa[8], pb[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            pa[i] = (float)i;
+            pb[i] = 1.0f;
+        }
+        EXPECT_TRUE(session->bindInput(0, pa, sizeof(pa)));
+        EXPECT_TRUE(session->bindInput(1, pb, sizeof(pb)));
+        session->run();
+        EXPECT_FLOAT_EQ(out->getRawDataPtr<float *>()[3], 4.0f);
+
+        // a pipelined request rebinds the inputs to its staging regions
+        alignas(64) float qa[8], qo[8];
+        for (int i = 0; i < 8; ++i)
+            qa[i] = 10.0f + (float)i;
+        session->runAsync({qa, pb}, {qo}).get();
+        EXPECT_FLOAT_EQ(qo[3], 14.0f);
+
+        // rebinding the same adopted pointers afterwards must not take the
+        // unchanged-pointer fast path and compute on the staging copies
+        for (int i = 0; i < 8; ++i)
+            pa[i] = 100.0f + (float)i;
+        EXPECT_TRUE(session->bindInput(0, pa, sizeof(pa)));
+        EXPECT_TRUE(session->bindInput(1, pb, sizeof(pb)));
+        session->run();
+        EXPECT_FLOAT_EQ(out->getRawDataPtr<float *>()[3], 104.0f);
+    }
+} // namespace infini
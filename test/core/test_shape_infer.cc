@@ -0,0 +1,51 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Graph, IncrementalShapeInfer)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({2, 3}, DataType::Float32);
+        Tensor w = g->addTensor({3, 4}, DataType::Float32);
+        auto matmul = g->addOp<MatmulObj>(x, w, nullptr);
+        auto relu = g->addOp<ReluObj>(matmul->getOutput(), nullptr);
+        auto out = relu->getOutput();
+        EXPECT_EQ(out->getDims(), (Shape{2, 4}));
+
+        // the serving path only grows the batch dimension
+        g->setTensorShape(x, {8, 3});
+        g->shape_infer();
+        EXPECT_EQ(matmul->getOutput()->getDims(), (Shape{8, 4}));
+        EXPECT_EQ(out->getDims(), (Shape{8, 4}));
+
+        // a clean graph is a no-op, as is a no-change setTensorShape
+        g->shape_infer();
+        g->setTensorShape(x, {8, 3});
+        g->shape_infer();
+        EXPECT_EQ(out->getDims(), (Shape{8, 4}));
+    }
+
+    TEST(Graph, ShapeInferStopsWhereUnchanged)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor a = g->addTensor({4, 1}, DataType::Float32);
+        Tensor b = g->addTensor({4, 6}, DataType::Float32);
+        auto add = g->addOp<AddObj>(a, b, nullptr);
+        auto relu = g->addOp<ReluObj>(add->getOutput(), nullptr);
+
+        // {1, 6} still broadcasts to {4, 6}: the add's output shape is
+        // unchanged and propagation stops before the relu
+        g->setTensorShape(a, {1, 6});
+        g->shape_infer();
+        EXPECT_EQ(add->getOutput()->getDims(), (Shape{4, 6}));
+        EXPECT_EQ(relu->getOutput()->getDims(), (Shape{4, 6}));
+    }
+}
@@ -0,0 +1,57 @@
+#include "core/tensor.h"
+#include "utils/small_vector.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(SmallVector, InlineStorage)
+    {
+        Shape s{1, 2, 3, 4};
+        EXPECT_EQ(s.size(), (size_t)4);
+        EXPECT_EQ(s.capacity(), (size_t)8);
+        EXPECT_EQ(s[2], 3);
+        EXPECT_EQ(s.back(), 4);
+
+        Shape copy = s;
+        copy[0] = 7;
+        EXPECT_EQ(s[0], 1);
+        EXPECT_EQ(copy, (Shape{7, 2, 3, 4}));
+        EXPECT_NE(copy, s);
+    }
+
+    TEST(SmallVector, HeapSpill)
+    {
+        Shape s;
+        for (int i = 0; i < 20; ++i)
+            s.push_back(i);
+        EXPECT_EQ(s.size(), (size_t)20);
+        EXPECT_GE(s.capacity(), (size_t)20);
+        for (int i = 0; i < 20; ++i)
+            EXPECT_EQ(s[i], i);
+
+        // moving a spilled vector steals the heap buffer
+        Shape moved = std::move(s);
+        EXPECT_EQ(moved.size(), (size_t)20);
+        EXPECT_EQ(moved[19], 19);
+        EXPECT_TRUE(s.empty());
+    }
+
+    TEST(SmallVector, VectorInterop)
+    {
+        std::vector<int> v{4, 3, 2};
+        Shape s = v;
+        EXPECT_EQ(s, (Shape{4, 3, 2}));
+        std::vector<int> back = s;
+        EXPECT_EQ(back, v);
+    }
+
+    TEST(SmallVector, InsertErase)
+    {
+        Shape s{1, 2, 4};
+        s.insert(s.begin() + 2, 3);
+        EXPECT_EQ(s, (Shape{1, 2, 3, 4}));
+        s.erase(s.begin());
+        EXPECT_EQ(s, (Shape{2, 3, 4}));
+    }
+} // namespace infini
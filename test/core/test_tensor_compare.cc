@@ -0,0 +1,57 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(TensorCompare, CompareStats)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({1024}, DataType::Float32);
+        auto b = g->addTensor({1024}, DataType::Float32);
+        g->dataMalloc();
+        a->setData(IncrementalGenerator());
+        b->setData(IncrementalGenerator());
+
+        auto equalStats = a->compareData(b);
+        EXPECT_EQ(equalStats.mismatchCount, (size_t)0);
+        EXPECT_EQ(equalStats.firstMismatch, SIZE_MAX);
+
+        // perturb two elements; the stats pinpoint them without printing
+        auto ptr = b->getRawDataPtr<float *>();
+        ptr[100] += 1.0f;
+        ptr[900] += 2.0f;
+        auto stats = a->compareData(b);
+        EXPECT_EQ(stats.mismatchCount, (size_t)2);
+        EXPECT_EQ(stats.firstMismatch, (size_t)100);
+        EXPECT_GT(stats.maxError, 0.0);
+
+        EXPECT_FALSE(a->equalData(b));
+    }
+
+    TEST(TensorCompare, ParallelEqualData)
+    {
+        // large enough to take the block-parallel path
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        auto cpu = as<NativeCpuRuntimeObj>(runtime);
+        cpu->setNumThreads(4);
+        Graph g = make_ref<GraphObj>(runtime);
+        const int n = 1 << 21;
+        auto a = g->addTensor({n}, DataType::Float32);
+        auto b = g->addTensor({n}, DataType::Float32);
+        g->dataMalloc();
+        a->setData(IncrementalGenerator());
+        b->setData(IncrementalGenerator());
+        EXPECT_TRUE(a->equalData(b));
+
+        // large enough to clear the relative tolerance at this magnitude
+        b->getRawDataPtr<float *>()[n / 2] += 100.0f;
+        EXPECT_FALSE(a->equalData(b));
+        auto stats = a->compareData(b);
+        EXPECT_EQ(stats.mismatchCount, (size_t)1);
+        EXPECT_EQ(stats.firstMismatch, (size_t)(n / 2));
+        cpu->setNumThreads(1);
+    }
+} // namespace infini
@@ -0,0 +1,53 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+#include <cstdio>
+
+namespace infini
+{
+    TEST(TensorDump, RoundTrip)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto a = g->addTensor({4, 16}, DataType::Float32);
+        g->dataMalloc();
+        a->setData(IncrementalGenerator());
+
+        const char *path = "tensor_dump_test.itsr";
+        a->dumpTo(path);
+
+        // load into a fresh tensor of the same shape/dtype; storage is
+        // allocated on demand
+        Tensor b = make_ref<TensorObj>(Shape{4, 16}, DataType::Float32,
+                                       runtime);
+        b->loadFrom(path);
+        EXPECT_TRUE(b->equalData(a));
+        std::remove(path);
+    }
+
+    TEST(TensorDump, GraphDumpAll)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        auto x = g->addTensor({8}, DataType::Float32);
+        auto relu = g->addOp<ReluObj>(x, nullptr);
+        g->dataMalloc();
+        x->setData(IncrementalGenerator());
+        runtime->run(g);
+
+        EXPECT_EQ(g->dumpTensors("."), (size_t)2);
+        auto copy = make_ref<TensorObj>(Shape{8}, DataType::Float32, runtime);
+        copy->loadFrom("tensor_" +
+                       std::to_string(relu->getOutput()->getFuid()) +
+                       ".itsr");
+        EXPECT_TRUE(copy->equalData(relu->getOutput()));
+        std::remove(("tensor_" + std::to_string(x->getFuid()) + ".itsr")
+                        .c_str());
+        std::remove(("tensor_" +
+                     std::to_string(relu->getOutput()->getFuid()) + ".itsr")
+                        .c_str());
+    }
+} // namespace infini
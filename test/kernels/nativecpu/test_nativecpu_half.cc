@@ -0,0 +1,99 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+#include "utils/half.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Half, ConversionsRoundTrip) {
+    // exactly representable values survive fp32 -> half -> fp32
+    for (float v : {0.0f, 1.0f, -2.5f, 0.125f, 1024.0f}) {
+        EXPECT_EQ(halfBitsToFloat(floatToHalfBits(v)), v);
+        EXPECT_EQ(bf16BitsToFloat(floatToBf16Bits(v)), v);
+    }
+    // fp16 overflows to inf; bf16 keeps the fp32 exponent range but only
+    // 8 mantissa bits
+    EXPECT_EQ(floatToHalfBits(1e6f), (uint16_t)0x7C00);
+    float big = bf16BitsToFloat(floatToBf16Bits(1e30f));
+    EXPECT_LT(std::fabs(big - 1e30f) / 1e30f, 0.005f);
+}
+
+TEST(Half, SubnormalDecode) {
+    // fp16 subnormals: value = mant * 2^-24. All three forms — smallest,
+    // single high bit, mixed bits — plus the largest subnormal and the
+    // smallest normal on the boundary.
+    EXPECT_EQ(halfBitsToFloat(0x0001), 0x1p-24f);
+    EXPECT_EQ(halfBitsToFloat(0x0200), 0x1p-15f);
+    EXPECT_EQ(halfBitsToFloat(0x0201), 0x1p-15f + 0x1p-24f);
+    EXPECT_EQ(halfBitsToFloat(0x03FF), 0x3FF * 0x1p-24f);
+    EXPECT_EQ(halfBitsToFloat(0x0400), 0x1p-14f);
+    EXPECT_EQ(halfBitsToFloat(0x8001), -0x1p-24f);
+    // exact subnormal values round-trip bit-for-bit
+    for (uint16_t h : {(uint16_t)0x0001, (uint16_t)0x0200, (uint16_t)0x0201,
+                       (uint16_t)0x03FF, (uint16_t)0x8200}) {
+        EXPECT_EQ(floatToHalfBits(halfBitsToFloat(h)), h);
+    }
+}
+
+TEST(Half, ElementWiseAndRelu) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, 8}, DataType::Float16);
+    auto b = g->addTensor({2, 8}, DataType::Float16);
+    auto add = g->addOp<AddObj>(a, b, nullptr);
+    auto relu = g->addOp<ReluObj>(add->getOutput(), nullptr);
+    g->dataMalloc();
+    auto *pa = a->getRawDataPtr<uint16_t *>();
+    auto *pb = b->getRawDataPtr<uint16_t *>();
+    for (int i = 0; i < 16; ++i) {
+        pa[i] = floatToHalfBits(float(i - 8));
+        pb[i] = floatToHalfBits(0.5f);
+    }
+    runtime->run(g);
+    auto *out = relu->getOutput()->getRawDataPtr<uint16_t *>();
+    for (int i = 0; i < 16; ++i) {
+        float expect = std::max(0.0f, float(i - 8) + 0.5f);
+        EXPECT_FLOAT_EQ(halfBitsToFloat(out[i]), expect);
+    }
+}
+
+TEST(Half, CastRoundTripThroughGraph) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({64}, DataType::Float32);
+    auto down = g->addOp<CastObj>(x, nullptr, CastType::Float2Float16);
+    auto up = g->addOp<CastObj>(down->getOutput(), nullptr,
+                                CastType::Float162Float);
+    g->dataMalloc();
+    x->setData(IncrementalGenerator());
+    runtime->run(g);
+    EXPECT_EQ(down->getOutput()->getDType(), DataType::Float16);
+    // 0..63 are exactly representable in fp16
+    EXPECT_TRUE(up->getOutput()->equalData(x));
+}
+
+TEST(Half, MatmulComputesInFp32) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a16 = g->addTensor({8, 16}, DataType::BFloat16);
+    auto b16 = g->addTensor({16, 8}, DataType::BFloat16);
+    auto matmul = g->addOp<MatmulObj>(a16, b16, nullptr);
+    g->dataMalloc();
+    auto *pa = a16->getRawDataPtr<uint16_t *>();
+    auto *pb = b16->getRawDataPtr<uint16_t *>();
+    for (int i = 0; i < 8 * 16; ++i) {
+        pa[i] = floatToBf16Bits(1.0f);
+        pb[i] = floatToBf16Bits(0.5f);
+    }
+    runtime->run(g);
+    auto *out = matmul->getOutput()->getRawDataPtr<uint16_t *>();
+    for (int i = 0; i < 8 * 8; ++i) {
+        EXPECT_FLOAT_EQ(bf16BitsToFloat(out[i]), 8.0f);
+    }
+}
+
+} // namespace infini
@@ -0,0 +1,125 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/quantize.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Quantize, RoundTrip) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({4, 8}, DataType::Float32);
+    auto q = g->addOp<QuantizeLinearObj>(x, nullptr, 0.05f, 3);
+    auto dq =
+        g->addOp<DequantizeLinearObj>(q->getOutput(), nullptr, 0.05f, 3);
+    EXPECT_EQ(q->getOutput()->getDType(), DataType::Int8);
+    EXPECT_EQ(dq->getOutput()->getDType(), DataType::Float32);
+    g->dataMalloc();
+    auto *px = x->getRawDataPtr<float *>();
+    for (int i = 0; i < 32; ++i) {
+        px[i] = (i - 16) * 0.1f;
+    }
+    runtime->run(g);
+    auto *pq = q->getOutput()->getRawDataPtr<int8_t *>();
+    auto *pd = dq->getOutput()->getRawDataPtr<float *>();
+    for (int i = 0; i < 32; ++i) {
+        int expect = std::lrintf(px[i] / 0.05f) + 3;
+        EXPECT_EQ(pq[i], std::min(127, std::max(-128, expect)));
+        // roundtrip error is at most half a quantization step
+        EXPECT_LE(std::fabs(pd[i] - px[i]), 0.025f + 1e-6f);
+    }
+}
+
+TEST(Quantize, Int8MatmulAccumulatesInInt32) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, 300}, DataType::Int8);
+    auto b = g->addTensor({300, 2}, DataType::Int8);
+    auto matmul = g->addOp<MatmulObj>(a, b, nullptr);
+    EXPECT_EQ(matmul->getOutput()->getDType(), DataType::Int32);
+    g->dataMalloc();
+    auto *pa = a->getRawDataPtr<int8_t *>();
+    auto *pb = b->getRawDataPtr<int8_t *>();
+    for (int i = 0; i < 600; ++i) {
+        pa[i] = 100;
+        pb[i] = 100;
+    }
+    runtime->run(g);
+    auto *pc = matmul->getOutput()->getRawDataPtr<int32_t *>();
+    for (int i = 0; i < 4; ++i) {
+        // 3,000,000 would overflow an int8 or int16 accumulator
+        EXPECT_EQ(pc[i], 300 * 100 * 100);
+    }
+}
+
+TEST(Quantize, OptimizeRewritesDequantizedMatmul) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto qa = g->addTensor({16, 32}, DataType::Int8);
+    auto qb = g->addTensor({32, 16}, DataType::Int8);
+    auto da = g->addOp<DequantizeLinearObj>(qa, nullptr, 0.1f, 0);
+    auto db = g->addOp<DequantizeLinearObj>(qb, nullptr, 0.25f, 0);
+    auto matmul =
+        g->addOp<MatmulObj>(da->getOutput(), db->getOutput(), nullptr);
+    auto relu = g->addOp<ReluObj>(matmul->getOutput(), nullptr);
+    auto out = relu->getOutput();
+
+    g->optimize();
+    // the two dequantizes fold into one after an int8 matmul
+    EXPECT_EQ(g->getOperators().size(), (size_t)3);
+    Operator newMatmul = nullptr;
+    for (auto &op : g->getOperators()) {
+        if (op->getOpType() == OpType::MatMul) {
+            newMatmul = op;
+        }
+    }
+    ASSERT_TRUE(newMatmul);
+    EXPECT_EQ(newMatmul->getInputs(0)->getDType(), DataType::Int8);
+    EXPECT_EQ(newMatmul->getOutput()->getDType(), DataType::Int32);
+
+    g->dataMalloc();
+    auto *pa = qa->getRawDataPtr<int8_t *>();
+    auto *pb = qb->getRawDataPtr<int8_t *>();
+    for (int i = 0; i < 16 * 32; ++i) {
+        pa[i] = (int8_t)(i % 11 - 5);
+    }
+    for (int i = 0; i < 32 * 16; ++i) {
+        pb[i] = (int8_t)(i % 7 - 3);
+    }
+    runtime->run(g);
+
+    // integer products dequantized once are exact up to fp32 rounding
+    auto *po = out->getRawDataPtr<float *>();
+    for (int i = 0; i < 16; ++i) {
+        for (int j = 0; j < 16; ++j) {
+            int32_t acc = 0;
+            for (int k = 0; k < 32; ++k) {
+                acc += (int)(int8_t)((i * 32 + k) % 11 - 5) *
+                       (int)(int8_t)((k * 16 + j) % 7 - 3);
+            }
+            float expect = std::max(0.0f, acc * 0.1f * 0.25f);
+            EXPECT_NEAR(po[i * 16 + j], expect, 1e-4f);
+        }
+    }
+}
+
+TEST(Quantize, AsymmetricZeroPointBlocksRewrite) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto qa = g->addTensor({4, 4}, DataType::Int8);
+    auto qb = g->addTensor({4, 4}, DataType::Int8);
+    auto da = g->addOp<DequantizeLinearObj>(qa, nullptr, 0.5f, 1);
+    auto db = g->addOp<DequantizeLinearObj>(qb, nullptr, 0.5f, 0);
+    g->addOp<MatmulObj>(da->getOutput(), db->getOutput(), nullptr);
+    g->optimize();
+    for (auto &op : g->getOperators()) {
+        if (op->getOpType() == OpType::MatMul) {
+            EXPECT_EQ(op->getInputs(0)->getDType(), DataType::Float32);
+        }
+    }
+}
+
+} // namespace infini
@@ -0,0 +1,64 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Relu, NativeCpu) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t1 = g->addTensor({2, 3}, DataType::Float32);
+    auto op = g->addOp<ReluObj>(t1, nullptr);
+    g->dataMalloc();
+    // -3..2 so the kernel sees both signs
+    t1->setData([](void *data, size_t size, DataType) {
+        auto ptr = reinterpret_cast<float *>(data);
+        for (size_t i = 0; i < size; ++i)
+            ptr[i] = (float)i - 3;
+    });
+
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(vector<float>{0, 0, 0, 0, 1, 2}));
+}
+
+TEST(Clip, NativeCpu) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t1 = g->addTensor({2, 3}, DataType::Float32);
+    auto op = g->addOp<ClipObj>(t1, nullptr, 1.0f, 4.0f);
+    g->dataMalloc();
+    t1->setData(IncrementalGenerator());
+
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(vector<float>{1, 1, 2, 3, 4, 4}));
+}
+
+TEST(Clip, NativeCpuNoBounds) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t1 = g->addTensor({2, 2}, DataType::Float32);
+    auto op =
+        g->addOp<ClipObj>(t1, nullptr, std::nullopt, std::nullopt);
+    g->dataMalloc();
+    t1->setData(IncrementalGenerator());
+
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(vector<float>{0, 1, 2, 3}));
+}
+
+TEST(Cast, NativeCpu) {
+    Runtime runtime = NativeCpuRuntimeObj::getInstance();
+    Graph g = make_ref<GraphObj>(runtime);
+    auto t1 = g->addTensor({2, 2}, DataType::Float32);
+    auto op = g->addOp<CastObj>(t1, nullptr, CastType::Float2Int32);
+    g->dataMalloc();
+    t1->setData(IncrementalGenerator());
+
+    runtime->run(g);
+    EXPECT_TRUE(
+        op->getOutput()->equalData(vector<int32_t>{0, 1, 2, 3}));
+}
+
+} // namespace infini
@@ -0,0 +1,71 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/reshape.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini
+{
+    TEST(Reshape, ShapeInference)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        {
+            Graph g = make_ref<GraphObj>(runtime);
+            Tensor i = g->addTensor({2, 3, 4}, DataType::Float32);
+            auto op = g->addOp<ReshapeObj>(i, nullptr, Shape{3, 2, 4});
+            EXPECT_EQ(op->getOutput()->getDims(), (Shape{3, 2, 4}));
+        }
+        {
+            // one -1 is inferred from the remaining dims
+            Graph g = make_ref<GraphObj>(runtime);
+            Tensor i = g->addTensor({2, 3, 4}, DataType::Float32);
+            auto op = g->addOp<ReshapeObj>(i, nullptr, Shape{-1, 4});
+            EXPECT_EQ(op->getOutput()->getDims(), (Shape{6, 4}));
+        }
+    }
+
+    TEST(Flatten, ShapeInference)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        {
+            Graph g = make_ref<GraphObj>(runtime);
+            Tensor i = g->addTensor({2, 3, 4, 5}, DataType::Float32);
+            auto op = g->addOp<FlattenObj>(i, nullptr, 2);
+            EXPECT_EQ(op->getOutput()->getDims(), (Shape{6, 20}));
+        }
+        {
+            Graph g = make_ref<GraphObj>(runtime);
+            Tensor i = g->addTensor({2, 3, 4, 5}, DataType::Float32);
+            auto op = g->addOp<FlattenObj>(i, nullptr, -1);
+            EXPECT_EQ(op->getOutput()->getDims(), (Shape{24, 5}));
+        }
+    }
+
+    TEST(Reshape, AliasedStorage)
+    {
+        Runtime runtime = NativeCpuRuntimeObj::getInstance();
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor i = g->addTensor({2, 6}, DataType::Float32);
+        auto reshape = g->addOp<ReshapeObj>(i, nullptr, Shape{3, 4});
+        auto relu = g->addOp<ReluObj>(reshape->getOutput(), nullptr);
+        g->dataMalloc();
+
+        // the reshape output borrows the input's storage...
+        EXPECT_EQ(reshape->getOutput()->getRawDataPtr<void *>(),
+                  i->getRawDataPtr<void *>());
+        // ...while the relu output owns its own bytes
+        EXPECT_NE(relu->getOutput()->getRawDataPtr<void *>(),
+                  i->getRawDataPtr<void *>());
+
+        // -6..5 so the relu after the aliased reshape sees both signs
+        i->setData([](void *data, size_t size, DataType) {
+            auto ptr = reinterpret_cast<float *>(data);
+            for (size_t i = 0; i < size; ++i)
+                ptr[i] = (float)i - 6;
+        });
+        runtime->run(g);
+        EXPECT_TRUE(relu->getOutput()->equalData(
+            vector<float>{0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5}));
+    }
+} // namespace infini